@@ -0,0 +1,73 @@
+#!/usr/bin/env python
+# Generates src/LIN_TAB.c from env/lincal.csv.
+#
+# Run from the repository root after editing the calibration data:
+#     python env/lingen.py
+#
+# The generated file is committed, so curve updates are reviewable as a data
+# diff and the build does not depend on a Python installation.
+
+import os
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+CSV = os.path.join(ROOT, 'env', 'lincal.csv')
+OUT = os.path.join(ROOT, 'src', 'LIN_TAB.c')
+
+HEADER = """\
+/**************************************************************************************************
+ * Name
+ *    LIN_TAB.c
+ *
+ * Purpose
+ *    Sensor linearization tables, generated by env/lingen.py from env/lincal.csv.
+ *
+ *    DO NOT EDIT: change env/lincal.csv and regenerate instead.
+ *************************************************************************************************/
+
+#include "LIN.h"
+
+"""
+
+
+def parse(path):
+    rows = []
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if not line or line.startswith('#'):
+                continue
+            idx, name, x0, shift, y = line.split(',')
+            rows.append((int(idx), name.strip(), int(x0), int(shift),
+                         [int(v) for v in y.split(';')]))
+    rows.sort()
+    if [r[0] for r in rows] != list(range(len(rows))):
+        raise SystemExit('lincal.csv: channel indices must be 0..N-1 without gaps')
+    return rows
+
+
+def emit(rows):
+    out = [HEADER]
+    for idx, name, x0, shift, y in rows:
+        out.append('/* %s */\n' % name)
+        out.append('static const sbyte2 lin_y_%02u[%u] =\n{\n' % (idx, len(y)))
+        for i in range(0, len(y), 8):
+            out.append('    %s,\n' % ', '.join('%6d' % v for v in y[i:i + 8]))
+        out.append('};\n\n')
+    out.append('const LIN_TABLE LIN_tables[%u] =\n{\n' % len(rows))
+    out.append('    /*  x0     shift  count  breakpoints */\n')
+    for idx, name, x0, shift, y in rows:
+        out.append('    { %5u,  %2u,  %2u,  lin_y_%02u },  /* %s */\n'
+                   % (x0, shift, len(y), idx, name))
+    out.append('};\n')
+    return ''.join(out)
+
+
+def main():
+    rows = parse(CSV)
+    with open(OUT, 'w') as f:
+        f.write(emit(rows))
+    print('wrote %s (%u channels)' % (OUT, len(rows)))
+
+
+if __name__ == '__main__':
+    main()
@@ -191,6 +191,9 @@ C_OPTS +=       --aliased_variables            \
 C_OPTS +=       -dHET_v2                      \
                 -d_AEABI_PORTABILITY_LEVEL=0
 
+# board variant for the compile-time pin map (see src/BOARD.c)
+C_OPTS +=       -dTARGET_$(TARGET)
+
 # insert the build date
 BUILDDATE_F    = $(ROOT_DIR)\env\builddate\getbuilddate.exe
 BUILDDATE_FUNC = $(subst \,\\,$(BUILDDATE_F))
@@ -0,0 +1,59 @@
+/**************************************************************************************************
+ * Name
+ *    ADC_SCAN.h
+ *
+ * Purpose
+ *    Batched acquisition of all configured analog inputs.
+ *
+ *    Channel configuration lives in one const table; ADC_SCAN_Read() fetches every channel in
+ *    one tight loop into a packed value array and collects the per-channel fresh flags into a
+ *    single bitmask, instead of ten scattered ubyte4/bool globals.
+ *************************************************************************************************/
+
+#ifndef ADC_SCAN_H_
+#define ADC_SCAN_H_
+
+#include "IO_ADC.h"
+#include "ptypes_tms570.h"
+
+/* indices into the packed value array, in scan order */
+#define ADC_SCAN_IDX_AI_103     0   /* температура НН,          IO_ADC_00 */
+#define ADC_SCAN_IDX_AI_127     1   /* температура ВН,          IO_ADC_01 */
+#define ADC_SCAN_IDX_AI_104     2   /* давление РТС 1-го моста, IO_ADC_02 */
+#define ADC_SCAN_IDX_AI_128     3   /* давление РТС 2-го моста, IO_ADC_03 */
+#define ADC_SCAN_IDX_AI_105     4   /* обмотка статора 1,       IO_ADC_04 */
+#define ADC_SCAN_IDX_AI_129     5   /* обмотка статора 2,       IO_ADC_05 */
+#define ADC_SCAN_IDX_AI_106     6   /* обмотка статора 3,       IO_ADC_06 */
+#define ADC_SCAN_IDX_AI_130     7   /* обмотка статора 4,       IO_ADC_07 */
+#define ADC_SCAN_IDX_AI_107     8   /* обмотка статора 5,       IO_ADC_08 */
+#define ADC_SCAN_IDX_AI_131     9   /* обмотка статора 6,       IO_ADC_09 */
+
+#define ADC_SCAN_NUM_CHANNELS   10
+
+/* packed sample array, written by ADC_SCAN_Read() */
+extern ubyte4 ADC_SCAN_values[ADC_SCAN_NUM_CHANNELS];
+
+/* bit n set: channel n delivered new data in the last ADC_SCAN_Read() */
+extern ubyte2 ADC_SCAN_fresh;
+
+#define ADC_SCAN_IS_FRESH(idx)  ((ubyte2)0 != (ADC_SCAN_fresh & (ubyte2)(1u << (idx))))
+
+/* the old per-sensor names, now views into the packed array */
+#define AI_103  (ADC_SCAN_values[ADC_SCAN_IDX_AI_103])
+#define AI_127  (ADC_SCAN_values[ADC_SCAN_IDX_AI_127])
+#define AI_104  (ADC_SCAN_values[ADC_SCAN_IDX_AI_104])
+#define AI_128  (ADC_SCAN_values[ADC_SCAN_IDX_AI_128])
+#define AI_105  (ADC_SCAN_values[ADC_SCAN_IDX_AI_105])
+#define AI_129  (ADC_SCAN_values[ADC_SCAN_IDX_AI_129])
+#define AI_106  (ADC_SCAN_values[ADC_SCAN_IDX_AI_106])
+#define AI_130  (ADC_SCAN_values[ADC_SCAN_IDX_AI_130])
+#define AI_107  (ADC_SCAN_values[ADC_SCAN_IDX_AI_107])
+#define AI_131  (ADC_SCAN_values[ADC_SCAN_IDX_AI_131])
+
+/* initializes all channels from the configuration table */
+IO_ErrorType ADC_SCAN_Init(void);
+
+/* reads all channels into ADC_SCAN_values and rebuilds ADC_SCAN_fresh */
+void ADC_SCAN_Read(void);
+
+#endif /* ADC_SCAN_H_ */
@@ -0,0 +1,58 @@
+/**************************************************************************************************
+ * Name
+ *    BOARD.h
+ *
+ * Purpose
+ *    Compile-time pin map for the selected hardware variant.
+ *
+ *    The Makefile passes TARGET_$(TARGET) to the compiler, and BOARD.c picks the matching set
+ *    of const descriptor tables. The acquisition and output modules (ADC_SCAN, DI_SCAN, DO_OUT,
+ *    PWM_OUT, WHEEL) only ever iterate these tables, so a new wiring variant is one table block
+ *    here instead of a diverging source copy -- one binary per target, zero runtime dispatch.
+ *
+ *    The table lengths and scan orders are fixed by the owning modules: index i of a table is
+ *    bit/index i of that module, on every target.
+ *************************************************************************************************/
+
+#ifndef BOARD_H_
+#define BOARD_H_
+
+#include "ptypes_tms570.h"
+#include "ADC_SCAN.h"
+#include "DI_SCAN.h"
+#include "DO_OUT.h"
+#include "PWM_OUT.h"
+#include "WHEEL.h"
+
+/* one analog input: pin plus its acquisition mode */
+typedef struct board_adc_channel_
+{
+    ubyte1 channel;     /* IO_ADC_xx pin                  */
+    ubyte1 type;        /* IO_ADC_CURRENT/IO_ADC_ABSOLUTE */
+    ubyte1 range;       /* measurement range              */
+    ubyte1 pupd;        /* pull resistor configuration    */
+} BOARD_ADC_CHANNEL;
+
+/* one digital input: pin plus its pull resistor */
+typedef struct board_di_channel_
+{
+    ubyte1 channel;     /* IO_DI_xx pin                   */
+    ubyte1 pupd;        /* pull resistor configuration    */
+} BOARD_DI_CHANNEL;
+
+/* analog inputs, index == ADC_SCAN_IDX_xx */
+extern const BOARD_ADC_CHANNEL BOARD_adc_channels[ADC_SCAN_NUM_CHANNELS];
+
+/* digital inputs, index == bit position of the DI_SCAN word */
+extern const BOARD_DI_CHANNEL BOARD_di_channels[DI_SCAN_NUM_CHANNELS];
+
+/* digital outputs, index == DO_OUT_xx bit numbers */
+extern const ubyte1 BOARD_do_channels[DO_OUT_NUM_CHANNELS];
+
+/* PWM outputs, index == PWM_OUT_IDX_xx */
+extern const ubyte1 BOARD_pwm_channels[PWM_OUT_NUM_CHANNELS];
+
+/* wheel speed timer inputs, index == WHEEL_IDX_xx */
+extern const ubyte1 BOARD_pwd_channels[WHEEL_NUM_CHANNELS];
+
+#endif /* BOARD_H_ */
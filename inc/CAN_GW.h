@@ -0,0 +1,51 @@
+/**************************************************************************************************
+ * Name
+ *    CAN_GW.h
+ *
+ * Purpose
+ *    Table-driven CAN gateway engine.
+ *
+ *    Forwarding between buses is described as a const route table: match ID, acceptance mask,
+ *    destination write handle and an optional ID rewrite. CAN_GW_Process() runs a batch of
+ *    frames (usually a FIFO drain) against the table and enqueues matches into the software TX
+ *    queue -- one table entry per route instead of one copy-pasted if-block, and a whole burst
+ *    gateways in a single pass with no intermediate frame copies.
+ *************************************************************************************************/
+
+#ifndef CAN_GW_H_
+#define CAN_GW_H_
+
+#include "IO_CAN.h"
+#include "CAN_TX.h"
+#include "ptypes_tms570.h"
+
+/* route keeps the received identifier/format unchanged */
+#define CAN_GW_KEEP_ID          0xFFFFFFFFu
+#define CAN_GW_KEEP_FORMAT      0xFFu
+
+typedef struct can_gw_route_
+{
+    ubyte4         match_id;        /* frame matches if (id & match_mask) == match_id       */
+    ubyte4         match_mask;
+    const ubyte2 * dst_handle;      /* destination write handle (assigned at init time,
+                                       therefore referenced by pointer from the const table) */
+    ubyte4         rewrite_id;      /* new identifier or CAN_GW_KEEP_ID                     */
+    ubyte1         rewrite_format;  /* new format or CAN_GW_KEEP_FORMAT                     */
+    ubyte1         prof_section;    /* arrival-to-retransmit latency section (PROF_SECTION_
+                                       GW_xx) or CAN_TX_NO_PROF                             */
+} CAN_GW_ROUTE;
+
+/* runs frame_count frames against the route table, frames are rewritten in place
+ * before being enqueued; returns the number of forwarded frames
+ * arrival_stamp is the IO_RTC_StartTime() stamp taken at the FIFO drain, it rides
+ * along in the TX queue so the latency sample covers the full forwarding path */
+ubyte1 CAN_GW_Process(const CAN_GW_ROUTE * const routes,
+                      ubyte1 route_count,
+                      IO_CAN_DATA_FRAME * const frames,
+                      ubyte1 frame_count,
+                      ubyte4 arrival_stamp);
+
+/* frames which matched no route (since startup) */
+ubyte4 CAN_GW_UnroutedFrames(void);
+
+#endif /* CAN_GW_H_ */
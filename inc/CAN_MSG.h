@@ -0,0 +1,99 @@
+/**************************************************************************************************
+ * Name
+ *    CAN_MSG.h
+ *
+ * Purpose
+ *    Table-generated CAN signal packing for the MTU/INV message set.
+ *
+ *    Each message is described exactly once: ID, format, DLC and a signal list macro with one
+ *    X(byte position, signal) line per signal. CAN_MSG_DEFINE_PACK(msg) then expands to a pack
+ *    function which writes the signals straight into IO_CAN_DATA_FRAME::data -- plain stores and
+ *    masked shifts, no per-signal function calls, and no hand-copied byte assignments to drift
+ *    out of sync with the message description.
+ *
+ *    Usage (in the translation unit which owns the frames):
+ *        CAN_MSG_DEFINE_PACK(MTU_SENSORS_1)
+ *        ...
+ *        CAN_MSG_Pack_MTU_SENSORS_1(&frame);
+ *************************************************************************************************/
+
+#ifndef CAN_MSG_H_
+#define CAN_MSG_H_
+
+#include "IO_CAN.h"
+#include "ptypes_tms570.h"
+
+/**************************************************************************************************
+ * Signal variables (defined in main.c, updated by the sensor path)
+ *************************************************************************************************/
+
+extern ubyte1 temp_n;   /* температура НН              */
+extern ubyte1 temp_v;   /* температура ВН              */
+extern ubyte1 PTC_1;    /* давление РТС 1-го моста     */
+extern ubyte1 PTC_2;    /* давление РТС 2-го моста     */
+extern ubyte1 RP;       /* редуктор полуприцепа        */
+extern ubyte1 BMKD_1;   /* БМКД 1-го моста             */
+extern ubyte1 BMKD_2;   /* БМКД 2-го моста             */
+extern ubyte1 RG;       /* задняя передача             */
+extern ubyte1 LG;       /* пониженная передача         */
+extern ubyte1 TED;      /* чек контакт ТЭД             */
+extern ubyte1 FAN;      /* чек контакт вентилятора     */
+extern ubyte1 K1;       /* чек контакт тока 1          */
+extern ubyte1 K2;       /* чек контакт тока 2          */
+extern ubyte1 K3;       /* чек контакт тока 3          */
+extern ubyte1 F;        /* чек ФОРСАЖ                  */
+
+/**************************************************************************************************
+ * Message set: describe each message once
+ *************************************************************************************************/
+
+#define CAN_MSG_MTU_SENSORS_1_ID        255
+#define CAN_MSG_MTU_SENSORS_1_FORMAT    IO_CAN_STD_FRAME
+#define CAN_MSG_MTU_SENSORS_1_DLC       8
+#define CAN_MSG_MTU_SENSORS_1_LIST(X) \
+    X(0, temp_n)  \
+    X(1, temp_v)  \
+    X(2, PTC_1)   \
+    X(3, PTC_2)   \
+    X(4, RP)      \
+    X(5, BMKD_1)  \
+    X(6, BMKD_2)  \
+    X(7, RG)
+
+#define CAN_MSG_MTU_SENSORS_2_ID        254
+#define CAN_MSG_MTU_SENSORS_2_FORMAT    IO_CAN_STD_FRAME
+#define CAN_MSG_MTU_SENSORS_2_DLC       8
+#define CAN_MSG_MTU_SENSORS_2_LIST(X) \
+    X(0, LG)   \
+    X(1, TED)  \
+    X(2, FAN)  \
+    X(3, K1)   \
+    X(4, K2)   \
+    X(5, K3)   \
+    X(6, F)    \
+    X(7, 0)
+
+/**************************************************************************************************
+ * Generator
+ *************************************************************************************************/
+
+/* one full-byte signal */
+#define CAN_MSG_EMIT_BYTE(pos, sig) \
+    frame->data[(pos)] = (ubyte1)(sig);
+
+/* sub-byte signal primitive for future messages: masked read-modify-write of one data byte */
+#define CAN_MSG_PUT_BITS(frame, pos, shift, mask, value) \
+    ((frame)->data[(pos)] = (ubyte1)(((frame)->data[(pos)] & (ubyte1)(~((mask) << (shift)))) | \
+                                     (ubyte1)(((value) & (mask)) << (shift))))
+
+/* expands to a pack function writing header and all signals of the message */
+#define CAN_MSG_DEFINE_PACK(msg)                                        \
+    static void CAN_MSG_Pack_##msg(IO_CAN_DATA_FRAME * const frame)     \
+    {                                                                   \
+        frame->id        = CAN_MSG_##msg##_ID;                          \
+        frame->id_format = CAN_MSG_##msg##_FORMAT;                      \
+        frame->length    = CAN_MSG_##msg##_DLC;                         \
+        CAN_MSG_##msg##_LIST(CAN_MSG_EMIT_BYTE)                         \
+    }
+
+#endif /* CAN_MSG_H_ */
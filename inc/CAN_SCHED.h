@@ -0,0 +1,51 @@
+/**************************************************************************************************
+ * Name
+ *    CAN_SCHED.h
+ *
+ * Purpose
+ *    Deadline-aware transmit scheduling on top of the CAN_TX queues.
+ *
+ *    Periodic messages register once with period, phase and deadline; CAN_SCHED_Service() runs
+ *    every tick and releases at most one frame per call, lowest CAN identifier first among the
+ *    released messages. The phases spread our transmissions across the cycle instead of firing
+ *    everything back-to-back at the start of the 10 ms slot, which keeps the 250 kbit/s bus free
+ *    for lower-priority nodes and cuts the worst-case wait for the forwarded inverter frames.
+ *    A message still queued when its deadline expires counts a deadline miss and goes out at the
+ *    next opportunity anyway.
+ *************************************************************************************************/
+
+#ifndef CAN_SCHED_H_
+#define CAN_SCHED_H_
+
+#include "IO_CAN.h"
+#include "ptypes_tms570.h"
+
+/* number of periodic messages which can be registered */
+#define CAN_SCHED_MAX_MSGS      8
+
+/* fills in the complete frame (header and data) when the message is released */
+typedef void (*CAN_SCHED_PACK_FN)(IO_CAN_DATA_FRAME * const frame);
+
+/* forgets all registered messages */
+void CAN_SCHED_Init(void);
+
+/* registers a periodic message on a CAN_TX write handle
+ *    id           identifier, used only for priority ordering among released messages
+ *    period_ms    release period
+ *    phase_ms     release offset within the period, spreads the bus load
+ *    deadline_ms  latest acceptable transmission after release, misses are counted
+ * returns IO_E_CAN_MAX_HANDLES_REACHED if all message slots are taken */
+IO_ErrorType CAN_SCHED_Add(ubyte2 handle,
+                           ubyte4 id,
+                           ubyte2 period_ms,
+                           ubyte2 phase_ms,
+                           ubyte2 deadline_ms,
+                           CAN_SCHED_PACK_FN pack);
+
+/* releases due messages and enqueues at most one frame, to be called every tick */
+void CAN_SCHED_Service(ubyte4 tick_ms);
+
+/* messages which were still waiting when their deadline expired (since CAN_SCHED_Init) */
+ubyte4 CAN_SCHED_DeadlineMisses(void);
+
+#endif /* CAN_SCHED_H_ */
@@ -0,0 +1,55 @@
+/**************************************************************************************************
+ * Name
+ *    CAN_TX.h
+ *
+ * Purpose
+ *    Software transmit queue over IO_CAN_WriteMsg()/IO_CAN_MsgStatus().
+ *
+ *    The driver write message objects can hold only one frame at a time, so writing several
+ *    frames back-to-back forces a busy-wait of ~500 us per frame at 250 kbit/s. This layer
+ *    enqueues frames into a RAM ring buffer instantly and hands them to the hardware whenever
+ *    the message object is free, so the control loop never blocks on bus arbitration.
+ *************************************************************************************************/
+
+#ifndef CAN_TX_H_
+#define CAN_TX_H_
+
+#include "IO_CAN.h"
+#include "ptypes_tms570.h"
+
+/* number of write handles which can be registered (one queue each) */
+#define CAN_TX_MAX_QUEUES       4
+
+/* depth of one transmit ring buffer, in frames (power of two) */
+#define CAN_TX_QUEUE_DEPTH      16
+
+/* no latency section attached to a frame (see CAN_TX_EnqueueStamped) */
+#define CAN_TX_NO_PROF          0xFFu
+
+/* resets all queues, forgets all registered handles */
+void CAN_TX_Init(void);
+
+/* registers a write handle (from IO_CAN_ConfigMsg) for queued transmission
+ * returns IO_E_CAN_MAX_HANDLES_REACHED if all queue slots are taken */
+IO_ErrorType CAN_TX_Register(ubyte2 handle);
+
+/* copies one frame into the ring buffer of the given handle, never blocks
+ * returns IO_E_BUSY and counts a drop if the ring is full */
+IO_ErrorType CAN_TX_Enqueue(ubyte2 handle, const IO_CAN_DATA_FRAME * const frame);
+
+/* like CAN_TX_Enqueue, but the frame carries an IO_RTC_StartTime() stamp; when the
+ * frame is handed to the hardware, the elapsed time since the stamp is recorded
+ * into the given profiler section (pass CAN_TX_NO_PROF to skip the measurement) */
+IO_ErrorType CAN_TX_EnqueueStamped(ubyte2 handle,
+                                   const IO_CAN_DATA_FRAME * const frame,
+                                   ubyte4 arrival_stamp,
+                                   ubyte1 prof_section);
+
+/* hands pending frames to the hardware, to be called at least once per cycle
+ * transmits as many frames as the message objects accept without waiting */
+void CAN_TX_Service(void);
+
+/* frames dropped because a ring was full (since CAN_TX_Init) */
+ubyte4 CAN_TX_DroppedFrames(void);
+
+#endif /* CAN_TX_H_ */
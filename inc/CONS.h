@@ -0,0 +1,48 @@
+/**************************************************************************************************
+ * Name
+ *    CONS.h
+ *
+ * Purpose
+ *    Serial diagnostics console on the UART service connector.
+ *
+ *    A small command parser is fed a few bytes per cycle from IO_UART_Read(); responses are
+ *    formatted into a static ring buffer and trickled out with writes sized to the free space
+ *    IO_UART_GetTxStatus() reports -- the loop never blocks on the line. Large dumps (the
+ *    parameter table, the profiler histograms) are formatted incrementally, one item per call,
+ *    so a dump costs microseconds per cycle instead of milliseconds at once.
+ *
+ *    Commands (terminated by CR or LF):
+ *        help    command overview
+ *        par     parameter table (id, name, value)
+ *        prof    profiler sections: min/max/mean/count plus the log2 histogram
+ *        stat    module counters (drops, overruns, deadline misses)
+ *************************************************************************************************/
+
+#ifndef CONS_H_
+#define CONS_H_
+
+#include "IO_UART.h"
+#include "ptypes_tms570.h"
+
+/* line settings of the service connector */
+#define CONS_BAUDRATE           115200u
+
+/* output ring: large enough for the longest burst of response lines (power of two) */
+#define CONS_TX_RING_SIZE       1024
+
+/* command line length limit, longer input is discarded up to the next terminator */
+#define CONS_LINE_SIZE          32
+
+/* bytes taken from the receive buffer per call, bounds the parse cost per cycle */
+#define CONS_RX_CHUNK           8
+
+/* initializes the UART and resets parser and ring */
+IO_ErrorType CONS_Init(void);
+
+/* reads input, advances running dumps, trickles the ring out; call from a slow rate group */
+void CONS_Task(void);
+
+/* response bytes thrown away because the ring was full */
+ubyte4 CONS_DroppedBytes(void);
+
+#endif /* CONS_H_ */
@@ -0,0 +1,59 @@
+/**************************************************************************************************
+ * Name
+ *    DIAG_LOG.h
+ *
+ * Purpose
+ *    Lock-free diagnostic event ring between the error callbacks and the main loop.
+ *
+ *    APPL_ErrorCb()/APPL_NotifyCb() run in the diagnostic context, not in main(), so the ring
+ *    is strict single-producer/single-consumer: the producer touches only the head index, the
+ *    consumer only the tail, both free-running and masked like the CAN_TX rings, so no locking
+ *    and no allocation anywhere. Recording an event is a handful of stores -- no driver calls,
+ *    timestamp is the scheduler tick -- so the error path can never stretch past the watchdog
+ *    window. DIAG_LOG_Report() drains the ring from a slow rate group onto a CAN handle.
+ *************************************************************************************************/
+
+#ifndef DIAG_LOG_H_
+#define DIAG_LOG_H_
+
+#include "DIAG_Constants.h"
+#include "ptypes_tms570.h"
+
+/* depth of the event ring, in entries (power of two) */
+#define DIAG_LOG_DEPTH          16
+
+/* CAN identifier of the diagnostic report frames */
+#define DIAG_LOG_REPORT_ID      0x710
+
+/* event sources */
+#define DIAG_LOG_SRC_ERROR      1   /* APPL_ErrorCb                            */
+#define DIAG_LOG_SRC_NOTIFY     2   /* APPL_NotifyCb                           */
+#define DIAG_LOG_SRC_APPL       3   /* application counters, see Housekeeping  */
+
+/* one recorded event */
+typedef struct diag_log_entry_
+{
+    ubyte4 tick;                /* scheduler tick at recording time */
+    ubyte4 faulty_value;
+    ubyte1 source;              /* DIAG_LOG_SRC_xx                  */
+    ubyte1 diag_state;
+    ubyte1 error_code;
+    ubyte1 device_num;
+} DIAG_LOG_ENTRY;
+
+/* resets the ring */
+void DIAG_LOG_Init(void);
+
+/* producer side: records one event, callback context safe, bounded to a few stores
+ * silently overwrites nothing -- when the ring is full the event is dropped and counted */
+void DIAG_LOG_Record(ubyte1 source,
+                     ubyte1 diag_state,
+                     const DIAG_ERRORCODE * const error);
+
+/* consumer side: emits queued events as CAN frames, to be called from a slow rate group */
+void DIAG_LOG_Report(ubyte2 handle);
+
+/* events dropped because the ring was full (since DIAG_LOG_Init) */
+ubyte4 DIAG_LOG_DroppedEvents(void);
+
+#endif /* DIAG_LOG_H_ */
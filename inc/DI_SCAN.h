@@ -0,0 +1,67 @@
+/**************************************************************************************************
+ * Name
+ *    DI_SCAN.h
+ *
+ * Purpose
+ *    Batched acquisition of all digital inputs into one packed 32-bit word.
+ *
+ *    The channel list lives in one const table; DI_SCAN_Read() samples every channel in one
+ *    loop, runs an incremental per-channel debounce and maintains a single debounced state
+ *    word. Conditions over several inputs become one AND+compare against a named mask instead
+ *    of chains of scattered bool globals (which also invited precedence bugs like
+ *    DI_132&&DI_109&&DI_133&&DI_110==TRUE).
+ *************************************************************************************************/
+
+#ifndef DI_SCAN_H_
+#define DI_SCAN_H_
+
+#include "IO_DIO.h"
+#include "ptypes_tms570.h"
+
+/* consecutive identical samples needed before a bit flips (at the 1 ms scan rate) */
+#define DI_SCAN_DEBOUNCE_COUNT  3
+
+/* bit masks of the packed input word, index == table position in DI_SCAN.c */
+#define DI_SCAN_RP      ((ubyte4)(1u << 0))     /* DI_108 редуктор полуприцепа, IO_DI_58 */
+#define DI_SCAN_BMKD_1  ((ubyte4)(1u << 1))     /* DI_132 БМКД 1-го моста,      IO_DI_59 */
+#define DI_SCAN_BMKD_2  ((ubyte4)(1u << 2))     /* DI_109 БМКД 2-го моста,      IO_DI_60 */
+#define DI_SCAN_RG      ((ubyte4)(1u << 3))     /* DI_133 задняя передача,      IO_DI_61 */
+#define DI_SCAN_LG      ((ubyte4)(1u << 4))     /* DI_110 пониженная передача,  IO_DI_62 */
+#define DI_SCAN_TED     ((ubyte4)(1u << 5))     /* DI_134 чек контакт ТЭД,      IO_DI_63 */
+#define DI_SCAN_FAN     ((ubyte4)(1u << 6))     /* DI_111 чек вентилятора,      IO_DI_64 */
+#define DI_SCAN_K1      ((ubyte4)(1u << 7))     /* DI_135 чек контакт тока 1,   IO_DI_65 */
+#define DI_SCAN_K2      ((ubyte4)(1u << 8))     /* DI_112 чек контакт тока 2,   IO_DI_66 */
+#define DI_SCAN_K3      ((ubyte4)(1u << 9))     /* DI_136 чек контакт тока 3,   IO_DI_67 */
+#define DI_SCAN_F       ((ubyte4)(1u << 10))    /* DI_113 чек ФОРСАЖ,           IO_DI_68 */
+
+#define DI_SCAN_NUM_CHANNELS    11
+
+/* all four interlocks required to enable the TED */
+#define DI_SCAN_TED_INTERLOCK   (DI_SCAN_BMKD_1 | DI_SCAN_BMKD_2 | DI_SCAN_RG | DI_SCAN_LG)
+
+/* the old per-input names, now views into the packed word */
+#define DI_108  (0u != (DI_SCAN_State() & DI_SCAN_RP))
+#define DI_132  (0u != (DI_SCAN_State() & DI_SCAN_BMKD_1))
+#define DI_109  (0u != (DI_SCAN_State() & DI_SCAN_BMKD_2))
+#define DI_133  (0u != (DI_SCAN_State() & DI_SCAN_RG))
+#define DI_110  (0u != (DI_SCAN_State() & DI_SCAN_LG))
+#define DI_134  (0u != (DI_SCAN_State() & DI_SCAN_TED))
+#define DI_111  (0u != (DI_SCAN_State() & DI_SCAN_FAN))
+#define DI_135  (0u != (DI_SCAN_State() & DI_SCAN_K1))
+#define DI_112  (0u != (DI_SCAN_State() & DI_SCAN_K2))
+#define DI_136  (0u != (DI_SCAN_State() & DI_SCAN_K3))
+#define DI_113  (0u != (DI_SCAN_State() & DI_SCAN_F))
+
+/* initializes all channels from the configuration table */
+IO_ErrorType DI_SCAN_Init(void);
+
+/* samples all channels in one pass and updates the debounced state word */
+void DI_SCAN_Read(void);
+
+/* debounced input word */
+ubyte4 DI_SCAN_State(void);
+
+/* raw input word of the last sample (before debouncing) */
+ubyte4 DI_SCAN_Raw(void);
+
+#endif /* DI_SCAN_H_ */
@@ -0,0 +1,43 @@
+/**************************************************************************************************
+ * Name
+ *    DO_OUT.h
+ *
+ * Purpose
+ *    Change-detection shadow over the digital outputs.
+ *
+ *    The application states its intent through a packed desired-state word; DO_OUT_Flush()
+ *    compares it against the last word actually written and calls IO_DO_Set() only for bits
+ *    which changed. In steady state the five driver calls per cycle drop to zero, reclaiming
+ *    their diagnostic bookkeeping time for the control path. A forced refresh rewrites every
+ *    output once per DO_OUT_REFRESH_CYCLES flushes so the shadow can never diverge from the
+ *    hardware for longer than that.
+ *************************************************************************************************/
+
+#ifndef DO_OUT_H_
+#define DO_OUT_H_
+
+#include "IO_DIO.h"
+#include "ptypes_tms570.h"
+
+/* output bits, numbered in scan order of the channel table in DO_OUT.c */
+#define DO_OUT_BSKR_COIL_1  ((ubyte1)(1u << 0))    /* IO_DO_16, катушка 1 БСКР, 149 pin  */
+#define DO_OUT_BSKR_COIL_2  ((ubyte1)(1u << 1))    /* IO_DO_17, катушка 2 БСКР, 173 pin  */
+#define DO_OUT_BSKR_COIL_3  ((ubyte1)(1u << 2))    /* IO_DO_18, катушка 3 БСКР, 152 pin  */
+#define DO_OUT_NUM_CHANNELS 3
+/* реле ТЭД и вентилятора переехали на ШИМ-выходы тех же контактов, см. PWM_OUT.h */
+
+#define DO_OUT_ALL          ((ubyte1)((1u << DO_OUT_NUM_CHANNELS) - 1u))
+
+/* rewrite all outputs every N-th flush regardless of the shadow (safety concept) */
+#define DO_OUT_REFRESH_CYCLES   100
+
+/* initializes all outputs to FALSE and primes the shadow word */
+IO_ErrorType DO_OUT_Init(void);
+
+/* sets/clears bits in the desired-state word; no driver call happens here */
+void DO_OUT_Set(ubyte1 mask, bool value);
+
+/* writes the changed bits to the hardware, to be called once per control cycle */
+IO_ErrorType DO_OUT_Flush(void);
+
+#endif /* DO_OUT_H_ */
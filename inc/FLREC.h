@@ -0,0 +1,59 @@
+/**************************************************************************************************
+ * Name
+ *    FLREC.h
+ *
+ * Purpose
+ *    Flight recorder: per-cycle records to external flash for field incident analysis.
+ *
+ *    Records accumulate in one of two RAM buffers; the control loop only pays one struct copy
+ *    per logged cycle. When a buffer fills, it is handed to FLREC_Task(), which pushes it to
+ *    external flash through the asynchronous IO_FLASH_GetStatus() machinery, pre-erases the
+ *    next block ahead of the write head, and rotates across flash banks via
+ *    IO_FLASH_BankSelect() so wear spreads over the whole part.
+ *************************************************************************************************/
+
+#ifndef FLREC_H_
+#define FLREC_H_
+
+#include "IO_FLASH.h"
+#include "ptypes_tms570.h"
+
+/* one logged cycle, packed to 32 bytes */
+typedef struct flrec_record_
+{
+    ubyte4 tick;        /* scheduler tick of the sample          */
+    ubyte2 ai[10];      /* analog inputs (low 16 bit of raw)     */
+    ubyte4 di;          /* packed digital input word             */
+    ubyte2 torque;      /* torque command                        */
+    ubyte2 flags;       /* reserved                              */
+} FLREC_RECORD;
+
+/* flush unit: 8 KiB per RAM buffer, two buffers */
+#define FLREC_BUF_SIZE          0x2000u
+
+/* buffers start with a header so dumps can be reassembled in order */
+#define FLREC_BUF_MAGIC         0xF11Du
+
+/* logging region: the uniform 64 KiB blocks, skipping the 8 KiB block area;
+ * the flash above is the firmware staging region (see FWUP.h) */
+#define FLREC_REGION_START      0x010000u
+#define FLREC_REGION_END        0x400000u
+#define FLREC_BLOCK_SIZE        0x10000u
+
+/* number of flash banks used for wear leveling */
+#define FLREC_NUM_BANKS         2
+
+/* initializes the flash driver and starts erasing the first block */
+IO_ErrorType FLREC_Init(void);
+
+/* appends one record to the active RAM buffer, cost is one struct copy
+ * records are dropped (and counted) while both buffers are busy */
+void FLREC_Log(const FLREC_RECORD * const record);
+
+/* drives erase/write in the background, to be called from a slow rate group */
+void FLREC_Task(void);
+
+/* buffers thrown away because the flash could not keep up */
+ubyte4 FLREC_DroppedBuffers(void);
+
+#endif /* FLREC_H_ */
@@ -0,0 +1,63 @@
+/**************************************************************************************************
+ * Name
+ *    FWUP.h
+ *
+ * Purpose
+ *    Background firmware staging over Ethernet.
+ *
+ *    Image blocks arrive over UDP during normal operation and are written to a staging region
+ *    in the external flash, consuming only cycle slack -- the vehicle keeps driving while the
+ *    image trickles in. Every block carries a CRC and is acknowledged, so the sender paces
+ *    itself and the integrity check is incremental instead of one long pass at the end. Only
+ *    the final switch goes through the CAN-era path: when the TTC-Downloader raises its
+ *    request (IO_DOWNLOAD_CheckRequest()), the application shuts down and calls
+ *    IO_DOWNLOAD_Launch(), turning minutes of flashing downtime into seconds.
+ *
+ *    Block datagram:  'F','W', seq_hi, seq_lo, total_hi, total_lo, crc_hi, crc_lo, payload
+ *    Acknowledgement: 'F','A', seq_hi, seq_lo, status
+ *************************************************************************************************/
+
+#ifndef FWUP_H_
+#define FWUP_H_
+
+#include "IO_UDP.h"
+#include "ptypes_tms570.h"
+
+/* staging region in the external flash, carved off the top of the logging region;
+ * always in this one bank -- the flight recorder rotates the selected bank for wear
+ * leveling, so both services re-select their own before every flash operation */
+#define FWUP_BANK               0
+#define FWUP_REGION_START       0x400000u
+#define FWUP_REGION_END         0x7F0000u
+#define FWUP_BLOCK_SIZE         0x10000u    /* flash erase unit in the region */
+
+/* payload bytes per UDP block (datagram = 8 byte header + payload) */
+#define FWUP_PAYLOAD_SIZE       512
+#define FWUP_HEADER_SIZE        8
+
+/* service port; the socket binds to the ECU address (same as the telemetry),
+ * acknowledgements go back to the updater host */
+#define FWUP_PORT               30300
+#define FWUP_LOCAL_IP           "10.100.30.200"
+#define FWUP_UPDATER_IP         "10.100.30.1"
+
+/* ack status codes */
+#define FWUP_ACK_OK             0   /* block staged                              */
+#define FWUP_ACK_AGAIN          1   /* flash busy or erase behind, resend        */
+#define FWUP_ACK_BAD_CRC        2   /* payload corrupted, resend                 */
+#define FWUP_ACK_BAD_SEQ        3   /* out of window or image does not fit       */
+
+/* creates the UDP socket and resets the transfer state
+ * (the Ethernet interface itself is brought up by TELEM_Init) */
+IO_ErrorType FWUP_Init(void);
+
+/* receives/stages pending blocks and drives the flash, to be called from a slow rate group */
+void FWUP_Task(void);
+
+/* TRUE once all blocks of the announced image are staged and verified */
+bool FWUP_ImageReady(void);
+
+/* blocks staged so far (diagnostics) */
+ubyte2 FWUP_StagedBlocks(void);
+
+#endif /* FWUP_H_ */
@@ -0,0 +1,59 @@
+/**************************************************************************************************
+ * Name
+ *    J1939.h
+ *
+ * Purpose
+ *    Minimal J1939 layer for the extended-ID inverter messages.
+ *
+ *    Incoming 29-bit frames are mapped PGN -> handler through a dense table indexed by
+ *    (PGN - base): the table is resolved at compile time and the lookup is one subtract and
+ *    one bounds check, so a FIFO drain stays linear in the number of frames received. The
+ *    layer also reassembles broadcast transport sessions (TP.BAM: one TP.CM announcement,
+ *    then TP.DT packets of 7 bytes) into a preallocated static buffer -- multi-packet
+ *    diagnostic data arrives through the same handler table as single frames, with zero
+ *    dynamic allocation.
+ *
+ *    Frames the layer consumes (TP protocol frames and handled PGNs) are removed from the
+ *    batch; everything else passes through untouched for the gateway.
+ *************************************************************************************************/
+
+#ifndef J1939_H_
+#define J1939_H_
+
+#include "IO_CAN.h"
+#include "ptypes_tms570.h"
+
+/* transport protocol PGNs (PDU1, destination in the PS byte) */
+#define J1939_PGN_TP_CM         0xEC00u
+#define J1939_PGN_TP_DT         0xEB00u
+
+/* TP.CM control byte for a broadcast announce message */
+#define J1939_TP_CM_BAM         32
+
+/* payload bytes per TP.DT packet */
+#define J1939_TP_PACKET_SIZE    7
+
+/* largest reassembled message the static session buffer accepts */
+#define J1939_TP_MAX_SIZE       256
+
+/* called with the complete message: single frames with length 8, reassembled
+ * transport sessions with their announced size */
+typedef void (* J1939_HANDLER)(ubyte4 pgn, const ubyte1 * data, ubyte2 length);
+
+/* registers the dense handler table: slot i serves PGN (pgn_base + i), NULL
+ * slots and PGNs outside the range pass through; source filters the transport
+ * sessions to one sender (the inverter) */
+void J1939_Init(ubyte4 pgn_base,
+                const J1939_HANDLER * handlers,
+                ubyte1 handler_count,
+                ubyte1 source);
+
+/* runs a drained batch: consumed frames are compacted away, returns the number
+ * of frames remaining for the gateway */
+ubyte1 J1939_Process(IO_CAN_DATA_FRAME * const frames, ubyte1 frame_count);
+
+/* transport sessions dropped (bad sequence, oversize, or a new announce
+ * while one was running) */
+ubyte4 J1939_AbortedSessions(void);
+
+#endif /* J1939_H_ */
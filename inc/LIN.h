@@ -0,0 +1,43 @@
+/**************************************************************************************************
+ * Name
+ *    LIN.h
+ *
+ * Purpose
+ *    Fixed-point sensor linearization over the packed ADC array.
+ *
+ *    Each channel carries a calibration curve as a const breakpoint table in flash; the
+ *    breakpoints are equally spaced in the raw domain, so the interpolation kernel finds the
+ *    segment with one shift instead of a search, and the fraction with one mask -- no floating
+ *    point and no per-sample branching. LIN_ConvertAll() runs all ten channels in one tight
+ *    loop right after ADC_SCAN_Read(). The tables themselves live in the generated LIN_TAB.c;
+ *    curve updates are edits to env/lincal.csv, not code changes.
+ *************************************************************************************************/
+
+#ifndef LIN_H_
+#define LIN_H_
+
+#include "ADC_SCAN.h"
+#include "ptypes_tms570.h"
+
+/* one calibration curve: engineering values at equally spaced raw breakpoints */
+typedef struct lin_table_
+{
+    ubyte2 x0;              /* raw value of the first breakpoint             */
+    ubyte1 shift;           /* log2 of the breakpoint spacing in raw units   */
+    ubyte1 count;           /* number of breakpoints                         */
+    const sbyte2 * y;       /* engineering values, 0.1 degC / 0.1 kPa        */
+} LIN_TABLE;
+
+/* generated from env/lincal.csv, one curve per ADC scan channel */
+extern const LIN_TABLE LIN_tables[ADC_SCAN_NUM_CHANNELS];
+
+/* engineering values of the last conversion, indexed like ADC_SCAN_values */
+extern sbyte2 LIN_values[ADC_SCAN_NUM_CHANNELS];
+
+/* interpolates one raw value through one curve (saturates at the table ends) */
+sbyte2 LIN_Convert(const LIN_TABLE * const table, ubyte4 raw);
+
+/* converts all channels from ADC_SCAN_values into LIN_values */
+void LIN_ConvertAll(void);
+
+#endif /* LIN_H_ */
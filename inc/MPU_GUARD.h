@@ -0,0 +1,44 @@
+/**************************************************************************************************
+ * Name
+ *    MPU_GUARD.h
+ *
+ * Purpose
+ *    Hardware guard strips around the application buffer pool.
+ *
+ *    The hot-path data structures (CAN transmit rings, diagnostic log ring, flight recorder
+ *    buffers, parameter shadow, input snapshots) are collected in one dedicated linker section
+ *    bracketed by two 32-byte address strips that no code may touch. MPU_GUARD_Init() covers
+ *    the strips with no-access User MPU regions, so a linear overrun walking off either end of
+ *    the pool raises a data abort immediately instead of silently corrupting a neighbour --
+ *    the per-access software bounds checks stay out of the 1 ms paths and protection costs
+ *    zero cycles at run time. The abort is reported through the diagnostic state machine and
+ *    APPL_ErrorCb() like every other fatal error, so it lands in the DIAG_LOG ring.
+ *
+ *    The pool addresses are fixed in bsp/mem_ttc500_bl.lsf (memory regions app_guard_ram and
+ *    guard_strip_lo/hi); the macros below must match the linker script.
+ *************************************************************************************************/
+
+#ifndef MPU_GUARD_H_
+#define MPU_GUARD_H_
+
+#include "IO_MPU.h"
+#include "ptypes_tms570.h"
+
+/* guard strip addresses, one 32-byte strip at each end of the pool
+ * (32-byte alignment satisfies the MPU start/size constraint) */
+#define MPU_GUARD_STRIP_LO      0x08030000u
+#define MPU_GUARD_STRIP_HI      0x08037FE0u
+
+/* places a buffer into the guarded pool section; expands to nothing on host
+ * builds (the simulation has no MPU and no TI pragmas) */
+#if defined(__TI_COMPILER_VERSION__)
+#define MPU_GUARD_PRAGMA(x)     _Pragma(#x)
+#define MPU_GUARD_DATA(symbol)  MPU_GUARD_PRAGMA(DATA_SECTION(symbol, ".APP_GUARD_VAR"))
+#else
+#define MPU_GUARD_DATA(symbol)
+#endif
+
+/* configures and enables the no-access regions over both guard strips */
+IO_ErrorType MPU_GUARD_Init(void);
+
+#endif /* MPU_GUARD_H_ */
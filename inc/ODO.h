@@ -0,0 +1,59 @@
+/**************************************************************************************************
+ * Name
+ *    ODO.h
+ *
+ * Purpose
+ *    Persistent odometer-style counters (operating time, event counts).
+ *
+ *    Counters live in RAM and an increment is a single add, callable from any context
+ *    including the error callbacks. Persistence is batched: a dirty set of counters is
+ *    committed at most once per ODO_COMMIT_PERIOD_S, round-robin across a multi-slot EEPROM
+ *    journal with a running sequence number and a CRC per slot -- the EEPROM sees one small
+ *    write per minute instead of one per event, and a commit torn by power loss only costs
+ *    the increments since the previous slot. Boot recovery reads the whole journal once
+ *    (one bounded scan over ODO_NUM_SLOTS slots) and continues from the newest valid slot;
+ *    increments made while the scan is still in flight are preserved.
+ *
+ *    The EEPROM is shared with the parameter store (PARAM); both services only issue
+ *    operations when IO_EEPROM_GetStatus() reports the driver free.
+ *************************************************************************************************/
+
+#ifndef ODO_H_
+#define ODO_H_
+
+#include "IO_EEPROM.h"
+#include "ptypes_tms570.h"
+
+/* counter ids */
+#define ODO_ID_SECONDS          0   /* operating time in seconds           */
+#define ODO_ID_TED_ENGAGE       1   /* TED interlock engagements           */
+#define ODO_ID_SAFESTATE        2   /* safe-state trips from APPL_ErrorCb  */
+#define ODO_ID_SPARE            3   /* reserved                            */
+#define ODO_NUM_COUNTERS        4
+
+/* journal region: behind the parameter block, ODO_NUM_SLOTS slots round robin */
+#define ODO_EEPROM_OFFSET       64
+#define ODO_NUM_SLOTS           8
+
+/* at most one journal write per this many seconds (wear: ~0.5 M writes per year
+ * spread over the slots, well under the part's endurance) */
+#define ODO_COMMIT_PERIOD_S     60
+
+/* resets the RAM counters and schedules the boot scan; requires IO_EEPROM_Init()
+ * to have run (PARAM_Init() on the critical path does that) */
+IO_ErrorType ODO_Init(void);
+
+/* one RAM add, no driver calls -- safe in the error callback context */
+void ODO_Increment(ubyte1 id);
+
+/* current value: journal base plus the increments since boot */
+ubyte4 ODO_Get(ubyte1 id);
+
+/* drives boot scan and batched commits, to be called from a slow rate group;
+ * also advances the operating-time counter (one call per 100 ms assumed) */
+void ODO_Task(void);
+
+/* journal writes since boot (diagnostics) */
+ubyte4 ODO_Commits(void);
+
+#endif /* ODO_H_ */
@@ -0,0 +1,49 @@
+/**************************************************************************************************
+ * Name
+ *    PARAM.h
+ *
+ * Purpose
+ *    EEPROM-backed parameter store with a RAM shadow and asynchronous write-back.
+ *
+ *    The parameter block is read once at startup into a RAM shadow (versioned, CRC-protected;
+ *    factory defaults are loaded if the block is invalid). All hot-path reads are plain RAM
+ *    accesses. PARAM_Set() only marks the block dirty; PARAM_Task() pushes dirty data to the
+ *    EEPROM through the asynchronous IO_EEPROM_GetStatus() state machine, so a parameter update
+ *    never stalls a control cycle.
+ *************************************************************************************************/
+
+#ifndef PARAM_H_
+#define PARAM_H_
+
+#include "IO_EEPROM.h"
+#include "ptypes_tms570.h"
+
+/* bump when the block layout changes, old blocks then fall back to defaults */
+#define PARAM_BLOCK_VERSION     1
+
+/* EEPROM offset of the parameter block */
+#define PARAM_EEPROM_OFFSET     0
+
+/* parameter identifiers */
+#define PARAM_ID_KP             0   /* torque PID proportional gain        */
+#define PARAM_ID_KI             1   /* torque PID integral gain            */
+#define PARAM_ID_KD             2   /* torque PID derivative gain          */
+#define PARAM_NUM_PARAMS        3
+
+/* initializes the EEPROM driver and blocks until the shadow is loaded,
+ * to be called once from Initialization() */
+IO_ErrorType PARAM_Init(void);
+
+/* RAM shadow read, safe in any hot path */
+ubyte2 PARAM_Get(ubyte1 id);
+
+/* updates the shadow and schedules the asynchronous write-back */
+void PARAM_Set(ubyte1 id, ubyte2 value);
+
+/* drives the write-back state machine, to be called from a slow rate group */
+void PARAM_Task(void);
+
+/* TRUE once a scheduled write-back has completely reached the EEPROM */
+bool PARAM_IsClean(void);
+
+#endif /* PARAM_H_ */
@@ -1,8 +1,55 @@
+/**************************************************************************************************
+ * Name
+ *    PID.h
+ *
+ * Purpose
+ *    Fixed-point PID controller with persistent state and saturating arithmetic.
+ *
+ *    Gains and internal terms are Q16 (16 fractional bits). All divisions happen at init time
+ *    (ki*dt and kd/dt are premultiplied), so one update is a handful of integer multiplies and
+ *    saturating adds. Several instances (torque, fan, ...) can run in the same cycle.
+ *************************************************************************************************/
+
 #ifndef PID_H_
 #define PID_H_
-#endif
 
 #include "ptypes_apdb.h"
 #include "ptypes_tms570.h"
 
-int PID(ubyte2 time, ubyte2 real, ubyte2 need, ubyte2 kp, ubyte2 ki, ubyte2 kd, ubyte2 previous_error, ubyte2 ut, ubyte2 ut_max);
\ No newline at end of file
+/* converts an integer gain to Q16 */
+#define PID_Q16(x)              (((sbyte4)(x)) << 16)
+
+/* Q16 representation of 1.0 */
+#define PID_Q16_ONE             ((sbyte4)0x00010000)
+
+typedef struct pid_state_
+{
+    sbyte4 kp_q16;          /* proportional gain                              */
+    sbyte4 ki_dt_q16;       /* integral gain premultiplied with dt at init    */
+    sbyte4 kd_inv_dt_q16;   /* derivative gain premultiplied with 1/dt        */
+    sbyte4 integral_q16;    /* accumulated integral term, clamped to out_max  */
+    sbyte4 previous_error;  /* error of the previous update                   */
+    sbyte4 out_min;         /* lower output/anti-windup limit, Q16            */
+    sbyte4 out_max;         /* upper output/anti-windup limit, Q16            */
+} PID_STATE;
+
+/* configures gains (Q16) and output limits (Q16) for a cycle period in us
+ * the only divisions of the controller happen here */
+void PID_Init(PID_STATE * const state,
+              sbyte4 kp_q16,
+              sbyte4 ki_q16,
+              sbyte4 kd_q16,
+              ubyte4 period_us,
+              sbyte4 out_min,
+              sbyte4 out_max);
+
+/* clears integral and derivative history, keeps the gains */
+void PID_Reset(PID_STATE * const state);
+
+/* one controller step with setpoint and measured value both in Q16,
+ * returns the clamped output in Q16 */
+sbyte4 PID_Update(PID_STATE * const state,
+                  sbyte4 setpoint,
+                  sbyte4 measured);
+
+#endif /* PID_H_ */
@@ -0,0 +1,64 @@
+/**************************************************************************************************
+ * Name
+ *    PROF.h
+ *
+ * Purpose
+ *    Lightweight cycle-budget profiler built on IO_RTC_GetTimeUS().
+ *
+ *    Sections are bracketed with PROF_Begin()/PROF_End(); per section the module accumulates
+ *    min/max/sum/count over the current report window plus a cumulative log2 histogram of the
+ *    execution time in us, all in static RAM. The cost per marker is one RTC driver call and a
+ *    few stores, cheap enough to stay enabled in production. PROF_Report() emits one CAN frame
+ *    per section and restarts the window.
+ *************************************************************************************************/
+
+#ifndef PROF_H_
+#define PROF_H_
+
+#include "IO_RTC.h"
+#include "ptypes_tms570.h"
+
+/* instrumented sections */
+#define PROF_SECTION_SENSORS    0
+#define PROF_SECTION_TORQUE     1
+#define PROF_SECTION_CAN1       2
+#define PROF_SECTION_CAN2       3
+#define PROF_SECTION_BOOT       4   /* one-shot: critical init to end of staged init */
+#define PROF_SECTION_GW_ROUTE_0 5   /* gateway arrival-to-retransmit, inv_sensors_m  */
+#define PROF_SECTION_GW_ROUTE_1 6   /* gateway arrival-to-retransmit, inv_sensors_e  */
+#define PROF_SECTION_GW_ROUTE_2 7   /* gateway arrival-to-retransmit, inv_sensors_t  */
+#define PROF_NUM_SECTIONS       8
+
+/* log2 histogram bins: bin n counts runs of [2^n .. 2^(n+1)) us */
+#define PROF_HIST_BINS          16
+
+/* base CAN identifier of the report frames (id = base + section) */
+#define PROF_REPORT_BASE_ID     0x700
+
+typedef struct prof_stats_
+{
+    ubyte2 min_us;                      /* shortest run in the current window  */
+    ubyte2 max_us;                      /* longest run in the current window   */
+    ubyte4 sum_us;                      /* for the mean over the window        */
+    ubyte2 count;                       /* runs in the current window          */
+    ubyte2 hist[PROF_HIST_BINS];        /* cumulative since startup            */
+} PROF_STATS;
+
+void PROF_Init(void);
+
+/* marks the start/end of one run of a section */
+void PROF_Begin(ubyte1 section);
+void PROF_End(ubyte1 section);
+
+/* records one externally timed run (for latencies measured outside a
+ * Begin/End bracket, e.g. the gateway arrival-to-retransmit times) */
+void PROF_Sample(ubyte1 section, ubyte4 elapsed_us);
+
+/* read access for telemetry (histogram is too wide for the CAN report) */
+const PROF_STATS * PROF_GetStats(ubyte1 section);
+
+/* enqueues one frame per section (min/max/mean/count) on the given write
+ * handle and restarts the report window */
+void PROF_Report(ubyte2 can_handle);
+
+#endif /* PROF_H_ */
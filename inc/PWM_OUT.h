@@ -0,0 +1,57 @@
+/**************************************************************************************************
+ * Name
+ *    PWM_OUT.h
+ *
+ * Purpose
+ *    PWM output stage with queue-based current feedback.
+ *
+ *    The fan and the TED relay coil move from bang-bang IO_DO_Set() switching onto the PWM
+ *    alternates of the same pins: the fan gets a real duty cycle from the stator temperatures
+ *    (no more relay chatter), the relay coil a full/hold profile. Current feedback comes in
+ *    batch from IO_PWM_GetCurQueue() -- all samples buffered since the last cycle in one driver
+ *    call -- and feeds an incremental moving average, which gives open-load and short detection
+ *    for free, without per-sample driver traffic.
+ *************************************************************************************************/
+
+#ifndef PWM_OUT_H_
+#define PWM_OUT_H_
+
+#include "IO_PWM.h"
+#include "ptypes_tms570.h"
+
+/* output channels, numbered in scan order of the channel table in PWM_OUT.c */
+#define PWM_OUT_IDX_TED_RELAY   0   /* IO_PWM_03, реле ТЭД, 176 pin (ex IO_DO_19)         */
+#define PWM_OUT_IDX_FAN         1   /* IO_PWM_04, вентилятор, 155 pin (ex IO_DO_20)       */
+#define PWM_OUT_NUM_CHANNELS    2
+
+/* PWM frequency for both coils */
+#define PWM_OUT_FREQUENCY       200     /* Hz */
+
+/* moving average weight: avg += (sample - avg) / 2^shift */
+#define PWM_OUT_AVG_SHIFT       3
+
+/* load supervision thresholds on the averaged current */
+#define PWM_OUT_OPEN_LOAD_MA    50      /* below this with duty on: open load   */
+#define PWM_OUT_OVERCURRENT_MA  4000    /* above this: overload / short         */
+
+/* load states reported by PWM_OUT_Fault() */
+#define PWM_OUT_LOAD_OK         0
+#define PWM_OUT_LOAD_OPEN       1
+#define PWM_OUT_LOAD_OVERCUR    2
+
+/* initializes the PWM channels from the configuration table, outputs off */
+IO_ErrorType PWM_OUT_Init(void);
+
+/* stores the desired duty cycle (0..65535 == 0..100%), written by PWM_OUT_Task() */
+void PWM_OUT_SetDuty(ubyte1 channel, ubyte2 duty);
+
+/* writes the duty cycles and drains the current queues, to be called once per cycle */
+void PWM_OUT_Task(void);
+
+/* moving average of the channel current in mA */
+ubyte2 PWM_OUT_Current(ubyte1 channel);
+
+/* PWM_OUT_LOAD_xx state from the last supervision pass */
+ubyte1 PWM_OUT_Fault(ubyte1 channel);
+
+#endif /* PWM_OUT_H_ */
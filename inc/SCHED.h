@@ -0,0 +1,47 @@
+/**************************************************************************************************
+ * Name
+ *    SCHED.h
+ *
+ * Purpose
+ *    Static task table scheduler with millisecond rate groups.
+ *
+ *    A 1 ms periodic RTC interrupt (IO_RTC_PeriodicInit) only increments a tick counter -- the
+ *    driver forbids I/O calls from the periodic interrupt -- and the main loop dispatches all
+ *    tasks whose period/phase match the current tick. Waiting for the next tick is a test of a
+ *    RAM counter instead of a hot spin through IO_RTC_GetTimeUS driver calls.
+ *************************************************************************************************/
+
+#ifndef SCHED_H_
+#define SCHED_H_
+
+#include "IO_RTC.h"
+#include "ptypes_tms570.h"
+
+/* length of one scheduler tick in us, also the safety command period */
+#define SCHED_TICK_US           1000
+
+/* maximum number of entries in the task table */
+#define SCHED_MAX_TASKS         16
+
+typedef void (*SCHED_TASK_FN)(void);
+
+/* clears the task table and starts the 1 ms periodic tick interrupt */
+IO_ErrorType SCHED_Init(void);
+
+/* adds a task called every period_ms, offset by phase_ms against tick 0
+ * tasks sharing a period run in registration order */
+IO_ErrorType SCHED_AddTask(SCHED_TASK_FN task, ubyte2 period_ms, ubyte2 phase_ms);
+
+/* runs all tasks due for the ticks elapsed since the last call */
+void SCHED_Dispatch(void);
+
+/* blocks until at least one new tick arrived since the last dispatch */
+void SCHED_WaitTick(void);
+
+/* free-running millisecond tick counter (wraps after ~49 days) */
+ubyte4 SCHED_GetTick(void);
+
+/* ticks which passed while the task set overran its slot */
+ubyte4 SCHED_OverrunTicks(void);
+
+#endif /* SCHED_H_ */
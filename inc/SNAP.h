@@ -0,0 +1,48 @@
+/**************************************************************************************************
+ * Name
+ *    SNAP.h
+ *
+ * Purpose
+ *    Double-buffered per-cycle input snapshot.
+ *
+ *    All inputs of one control cycle -- raw and linearized analog values, the debounced DI
+ *    word, the wheel speeds -- are gathered into one packed struct instead of globals scattered
+ *    across the data segment. Two buffers: the sensor path fills the back buffer and publishes
+ *    it with a single index store (atomic on this core), the control path reads the front
+ *    buffer, which never changes under it. Consistency holds by construction even if
+ *    acquisition later moves to another rate or context, and the whole hot working set sits in
+ *    a couple of cache lines.
+ *************************************************************************************************/
+
+#ifndef SNAP_H_
+#define SNAP_H_
+
+#include "ADC_SCAN.h"
+#include "WHEEL.h"
+#include "ptypes_tms570.h"
+
+/* every input the control path consumes in one cycle */
+typedef struct snap_inputs_
+{
+    ubyte4 tick;                                /* scheduler tick of the acquisition      */
+    ubyte4 di;                                  /* debounced DI word (DI_SCAN masks)      */
+    sbyte4 wheel_q16[WHEEL_NUM_CHANNELS];       /* axle speeds, Q16 rpm                   */
+    sbyte4 vehicle_speed_q16;                   /* average of both axles, Q16 rpm         */
+    ubyte2 ai_raw[ADC_SCAN_NUM_CHANNELS];       /* raw ADC values                         */
+    sbyte2 ai_eng[ADC_SCAN_NUM_CHANNELS];       /* linearized values, 0.1 degC / 0.1 kPa  */
+    ubyte2 ai_fresh;                            /* per-channel freshness bits             */
+} SNAP_INPUTS;
+
+/* resets both buffers */
+void SNAP_Init(void);
+
+/* producer side: the back buffer to fill for the next publish */
+SNAP_INPUTS * SNAP_Back(void);
+
+/* flips the buffers with one index store; the filled back buffer becomes the front */
+void SNAP_Publish(void);
+
+/* consumer side: the last published snapshot, immutable until the next SNAP_Front() */
+const SNAP_INPUTS * SNAP_Front(void);
+
+#endif /* SNAP_H_ */
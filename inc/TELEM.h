@@ -0,0 +1,41 @@
+/**************************************************************************************************
+ * Name
+ *    TELEM.h
+ *
+ * Purpose
+ *    Binary telemetry snapshots over UDP multicast.
+ *
+ *    All tuning data -- analog inputs, DI word, PID internals, profiler counters -- is packed
+ *    into one preformatted packet buffer: the header is written once at init, TELEM_Send() only
+ *    pokes the payload fields in place and hands the same buffer to IO_UDP_WriteTo(), with no
+ *    intermediate copies. Ethernet gives three orders of magnitude more bandwidth than the
+ *    250 kbit/s CAN links, without touching their budget. Multi-byte fields are big-endian
+ *    (native byte order of the TMS570).
+ *************************************************************************************************/
+
+#ifndef TELEM_H_
+#define TELEM_H_
+
+#include "IO_UDP.h"
+#include "PID.h"
+#include "ptypes_tms570.h"
+
+/* addresses follow the APDB: local IP 10.100.30.200, multicast group 239.0.0.1 */
+#define TELEM_LOCAL_IP          "10.100.30.200"
+#define TELEM_PC_IP             "10.100.30.1"
+#define TELEM_TARGET_IP         "239.0.0.1"
+#define TELEM_PORT              30200
+
+#define TELEM_PACKET_MAGIC      0x5454u     /* "TT" */
+#define TELEM_PACKET_VERSION    1
+
+/* brings up the Ethernet interface and the transmit socket */
+IO_ErrorType TELEM_Init(void);
+
+/* updates the payload in place and multicasts the packet */
+void TELEM_Send(ubyte4 tick, ubyte2 torque, const PID_STATE * const pid);
+
+/* packets which could not be handed to the stack */
+ubyte4 TELEM_DroppedPackets(void);
+
+#endif /* TELEM_H_ */
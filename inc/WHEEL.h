@@ -0,0 +1,43 @@
+/**************************************************************************************************
+ * Name
+ *    WHEEL.h
+ *
+ * Purpose
+ *    Wheel speed acquisition on the PWD timer inputs.
+ *
+ *    The wheel speed sensors are wired to complex PWD channels which timestamp edges in
+ *    hardware, so frequency comes with edge-capture resolution and no software edge counting.
+ *    WHEEL_Read() converts the accumulated frequency into a fixed-point axle speed per cycle;
+ *    WHEEL_Speed() serves as the feedback value for the torque PID.
+ *************************************************************************************************/
+
+#ifndef WHEEL_H_
+#define WHEEL_H_
+
+#include "IO_PWD.h"
+#include "ptypes_tms570.h"
+
+/* wheel speed channels */
+#define WHEEL_IDX_AXLE_1        0   /* IO_PWD_00, датчик скорости 1-го моста */
+#define WHEEL_IDX_AXLE_2        1   /* IO_PWD_01, датчик скорости 2-го моста */
+#define WHEEL_NUM_CHANNELS      2
+
+/* encoder pulses per wheel revolution */
+#define WHEEL_PULSES_PER_REV    60
+
+/* initializes the timer channels from the configuration table */
+IO_ErrorType WHEEL_Init(void);
+
+/* fetches the captured frequencies, to be called once per control cycle */
+void WHEEL_Read(void);
+
+/* wheel speed in RPM as Q16 (65536 == 1 rpm), 0 while the wheel stands */
+sbyte4 WHEEL_Speed(ubyte1 wheel);
+
+/* average of both axles in RPM as Q16, PID feedback for the torque loop */
+sbyte4 WHEEL_VehicleSpeed(void);
+
+/* TRUE if the channel delivered a valid capture in the last WHEEL_Read() */
+bool WHEEL_IsValid(ubyte1 wheel);
+
+#endif /* WHEEL_H_ */
@@ -0,0 +1,87 @@
+/**************************************************************************************************
+ * Name
+ *    SIM_IO.c
+ *
+ * Purpose
+ *    Host-side stub of the I/O driver surface used by the portable application modules.
+ *
+ *    Only the functions the simulated modules actually call are implemented; everything is
+ *    plain C so the logic links and runs on a PC. CAN transmission is modelled as an always
+ *    ready message object which captures every frame for the harness to inspect.
+ *************************************************************************************************/
+
+#include "ADC_SCAN.h"
+#include "IO_CAN.h"
+#include "IO_RTC.h"
+#include "SIM_IO.h"
+
+/**************************************************************************************************
+ * Global data (owned by ADC_SCAN.c on the target, by the stub in the simulation)
+ *************************************************************************************************/
+
+ubyte4 ADC_SCAN_values[ADC_SCAN_NUM_CHANNELS];
+ubyte2 ADC_SCAN_fresh;
+
+/**************************************************************************************************
+ * Static data
+ *************************************************************************************************/
+
+static IO_CAN_DATA_FRAME sim_io_frames[SIM_IO_MAX_FRAMES];
+static ubyte4 sim_io_frame_count;
+static ubyte4 sim_io_time_us;       /* stubbed RTC, advanced by the harness */
+
+/**************************************************************************************************
+ * Stubbed driver functions
+ *************************************************************************************************/
+
+IO_ErrorType IO_CAN_MsgStatus(ubyte2 handle)
+{
+    (void)handle;
+    return IO_E_OK;     /* the simulated message object is always free */
+}
+
+IO_ErrorType IO_CAN_WriteMsg(ubyte2 handle, const IO_CAN_DATA_FRAME * const data)
+{
+    (void)handle;
+    if (sim_io_frame_count < SIM_IO_MAX_FRAMES)
+    {
+        sim_io_frames[sim_io_frame_count] = *data;
+    }
+    sim_io_frame_count++;
+    return IO_E_OK;
+}
+
+IO_ErrorType IO_RTC_StartTime(ubyte4 * const timestamp)
+{
+    *timestamp = sim_io_time_us;
+    return IO_E_OK;
+}
+
+ubyte4 IO_RTC_GetTimeUS(ubyte4 timestamp)
+{
+    return sim_io_time_us - timestamp;
+}
+
+/**************************************************************************************************
+ * Harness access
+ *************************************************************************************************/
+
+void SIM_IO_Reset(void)
+{
+    sim_io_frame_count = 0;
+}
+
+void SIM_IO_AdvanceTimeUS(ubyte4 us)
+{
+    sim_io_time_us += us;
+}
+
+ubyte4 SIM_IO_SentFrames(void)
+{
+    return sim_io_frame_count;
+}
+
+const IO_CAN_DATA_FRAME * SIM_IO_Frame(ubyte4 index)
+{
+    return &sim_io_frames[index];
+}
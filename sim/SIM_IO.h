@@ -0,0 +1,30 @@
+/**************************************************************************************************
+ * Name
+ *    SIM_IO.h
+ *
+ * Purpose
+ *    Harness-side view of the stubbed I/O layer, see SIM_IO.c.
+ *************************************************************************************************/
+
+#ifndef SIM_IO_H_
+#define SIM_IO_H_
+
+#include "IO_CAN.h"
+#include "ptypes_tms570.h"
+
+/* frames the stub keeps for inspection (transmissions beyond this are only counted) */
+#define SIM_IO_MAX_FRAMES       4096
+
+/* forgets all captured frames */
+void SIM_IO_Reset(void);
+
+/* advances the stubbed IO_RTC clock (the simulation has no real time base) */
+void SIM_IO_AdvanceTimeUS(ubyte4 us);
+
+/* frames written through IO_CAN_WriteMsg() since the last reset */
+ubyte4 SIM_IO_SentFrames(void);
+
+/* captured frame by transmission order */
+const IO_CAN_DATA_FRAME * SIM_IO_Frame(ubyte4 index);
+
+#endif /* SIM_IO_H_ */
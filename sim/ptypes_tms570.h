@@ -0,0 +1,68 @@
+/**************************************************************************************************
+ * Name
+ *    ptypes_tms570.h (host simulation shadow)
+ *
+ * Purpose
+ *    Primitive data types for the host build.
+ *
+ *    Shadows inc/ptypes_tms570.h in the simulation: the target header maps ubyte4/sbyte4 to
+ *    `long`, which is 64 bit on a 64-bit host and silently breaks every 32-bit saturation and
+ *    wrap-around in the application code. This version pins the widths with <stdint.h>. It is
+ *    force-included by the sim Makefile (-include), so its include guard suppresses the target
+ *    header -- plain -I ordering cannot win because quoted includes resolve next to the
+ *    including header first.
+ *************************************************************************************************/
+
+#ifndef PTYPES_TMS570_H_
+#define PTYPES_TMS570_H_
+
+#include <stdint.h>
+
+typedef uint8_t                 ubyte1; /**< unsigned  8bit integer */
+typedef uint16_t                ubyte2; /**< unsigned 16bit integer */
+typedef uint32_t                ubyte4; /**< unsigned 32bit integer */
+typedef uint64_t                ubyte8; /**< unsigned 64bit integer */
+
+typedef int8_t                  sbyte1; /**< signed  8bit integer */
+typedef int16_t                 sbyte2; /**< signed 16bit integer */
+typedef int32_t                 sbyte4; /**< signed 32bit integer */
+typedef int64_t                 sbyte8; /**< signed 64bit integer */
+
+typedef float                   float4; /**< 32bit float type */
+typedef double                  float8; /**< 64bit float type */
+
+#ifndef __cplusplus
+    #ifndef bool
+        typedef unsigned char   bool;   /**< boolean type */
+    #endif
+#endif
+
+typedef unsigned char           BOOL;
+
+#ifndef NULL
+    #define NULL                ((void *)0U)
+#endif
+
+#ifndef NULL_PTR
+    #define NULL_PTR            ((void *)0U)
+#endif
+
+#ifndef FALSE
+    #define FALSE               ((bool)0U)
+#endif
+
+#ifndef TRUE
+    #define TRUE                ((bool)1U)
+#endif
+
+#define TT_FALSE                ((bool)0U)
+#define TT_TRUE                 ((bool)1U)
+
+#define UBYTE4_MAX_VALUE        ((ubyte4)0xFFFFFFFFU)
+#define UBYTE4_MIN_VALUE        ((ubyte4)0x00000000U)
+#define UBYTE2_MAX_VALUE        ((ubyte2)0xFFFFU)
+#define UBYTE2_MIN_VALUE        ((ubyte2)0x0000U)
+#define UBYTE1_MAX_VALUE        ((ubyte1)0xFFU)
+#define UBYTE1_MIN_VALUE        ((ubyte1)0x00U)
+
+#endif /* PTYPES_TMS570_H_ */
@@ -0,0 +1,69 @@
+/**************************************************************************************************
+ * Name
+ *    ADC_SCAN.c
+ *
+ * Purpose
+ *    Batched acquisition of all configured analog inputs, see ADC_SCAN.h.
+ *************************************************************************************************/
+
+#include "ADC_SCAN.h"
+#include "BOARD.h"
+#include "IO_Pin.h"
+
+/**************************************************************************************************
+ * Static data
+ *************************************************************************************************/
+
+/* pin assignments and acquisition modes come from the board layer (BOARD_adc_channels) */
+
+ubyte4 ADC_SCAN_values[ADC_SCAN_NUM_CHANNELS];
+ubyte2 ADC_SCAN_fresh;
+
+/**************************************************************************************************
+ * Functions
+ *************************************************************************************************/
+
+IO_ErrorType ADC_SCAN_Init(void)
+{
+    IO_ErrorType io_error = IO_E_OK;
+    ubyte1 i;
+
+    for (i = 0; i < ADC_SCAN_NUM_CHANNELS; i++)
+    {
+        IO_ErrorType channel_error;
+
+        channel_error = IO_ADC_ChannelInit(BOARD_adc_channels[i].channel,
+                                           BOARD_adc_channels[i].type,
+                                           BOARD_adc_channels[i].range,
+                                           BOARD_adc_channels[i].pupd,
+                                           IO_PIN_NONE,        /* no sensor supply */
+                                           NULL);
+        if (channel_error != IO_E_OK)
+        {
+            io_error = channel_error;   /* report the last failing channel */
+        }
+        ADC_SCAN_values[i] = 0;
+    }
+    ADC_SCAN_fresh = 0;
+    return io_error;
+}
+
+void ADC_SCAN_Read(void)
+{
+    ubyte2 fresh = 0;
+    ubyte1 i;
+
+    for (i = 0; i < ADC_SCAN_NUM_CHANNELS; i++)
+    {
+        bool fresh_flag = FALSE;
+
+        (void)IO_ADC_Get(BOARD_adc_channels[i].channel,
+                         &ADC_SCAN_values[i],
+                         &fresh_flag);
+        if (fresh_flag != FALSE)
+        {
+            fresh |= (ubyte2)(1u << i);
+        }
+    }
+    ADC_SCAN_fresh = fresh;
+}
@@ -0,0 +1,126 @@
+/**************************************************************************************************
+ * Name
+ *    BOARD.c
+ *
+ * Purpose
+ *    Per-target pin map tables, see BOARD.h. Exactly one variant block compiles in, selected
+ *    by the TARGET_$(TARGET) symbol from env/settings.mk.
+ *************************************************************************************************/
+
+#include "BOARD.h"
+#include "IO_Pin.h"
+
+/**************************************************************************************************
+ * HY-TTC 508 (trailer variant)
+ *
+ * Same transducers on the same input connector, but the 508 has the smaller power stage:
+ * the BSKR coils sit on the first high-side group and the PWM stage on the first two PWM
+ * pins, the wheel sensors on the second PWD pair.
+ *************************************************************************************************/
+#if defined(TARGET_TTC508)
+
+const BOARD_ADC_CHANNEL BOARD_adc_channels[ADC_SCAN_NUM_CHANNELS] =
+{
+    { IO_ADC_00, IO_ADC_CURRENT,  IO_ADC_NO_RANGE,  IO_ADC_NO_PULL },   /* AI_103 */
+    { IO_ADC_01, IO_ADC_CURRENT,  IO_ADC_NO_RANGE,  IO_ADC_NO_PULL },   /* AI_127 */
+    { IO_ADC_02, IO_ADC_CURRENT,  IO_ADC_NO_RANGE,  IO_ADC_NO_PULL },   /* AI_104 */
+    { IO_ADC_03, IO_ADC_CURRENT,  IO_ADC_NO_RANGE,  IO_ADC_NO_PULL },   /* AI_128 */
+    { IO_ADC_04, IO_ADC_ABSOLUTE, IO_ADC_RANGE_10V, IO_ADC_NO_PULL },   /* AI_105 */
+    { IO_ADC_05, IO_ADC_ABSOLUTE, IO_ADC_RANGE_10V, IO_ADC_NO_PULL },   /* AI_129 */
+    { IO_ADC_06, IO_ADC_ABSOLUTE, IO_ADC_RANGE_10V, IO_ADC_NO_PULL },   /* AI_106 */
+    { IO_ADC_07, IO_ADC_ABSOLUTE, IO_ADC_RANGE_10V, IO_ADC_NO_PULL },   /* AI_130 */
+    { IO_ADC_08, IO_ADC_ABSOLUTE, IO_ADC_RANGE_10V, IO_ADC_NO_PULL },   /* AI_107 */
+    { IO_ADC_09, IO_ADC_ABSOLUTE, IO_ADC_RANGE_10V, IO_ADC_NO_PULL }    /* AI_131 */
+};
+
+const BOARD_DI_CHANNEL BOARD_di_channels[DI_SCAN_NUM_CHANNELS] =
+{
+    { IO_DI_58, IO_DI_PU_10K },     /* bit 0,  DI_108 */
+    { IO_DI_59, IO_DI_PU_10K },     /* bit 1,  DI_132 */
+    { IO_DI_60, IO_DI_PU_10K },     /* bit 2,  DI_109 */
+    { IO_DI_61, IO_DI_PU_10K },     /* bit 3,  DI_133 */
+    { IO_DI_62, IO_DI_PU_10K },     /* bit 4,  DI_110 */
+    { IO_DI_63, IO_DI_PU_10K },     /* bit 5,  DI_134 */
+    { IO_DI_64, IO_DI_PU_10K },     /* bit 6,  DI_111 */
+    { IO_DI_65, IO_DI_PU_10K },     /* bit 7,  DI_135 */
+    { IO_DI_66, IO_DI_PU_10K },     /* bit 8,  DI_112 */
+    { IO_DI_67, IO_DI_PU_10K },     /* bit 9,  DI_136 */
+    { IO_DI_68, IO_DI_PU_10K }      /* bit 10, DI_113 */
+};
+
+const ubyte1 BOARD_do_channels[DO_OUT_NUM_CHANNELS] =
+{
+    IO_DO_00,   /* DO_OUT_BSKR_COIL_1, pin 149 */
+    IO_DO_01,   /* DO_OUT_BSKR_COIL_2, pin 173 */
+    IO_DO_02    /* DO_OUT_BSKR_COIL_3, pin 152 */
+};
+
+const ubyte1 BOARD_pwm_channels[PWM_OUT_NUM_CHANNELS] =
+{
+    IO_PWM_00,  /* PWM_OUT_IDX_TED_RELAY, pin 153 */
+    IO_PWM_01   /* PWM_OUT_IDX_FAN,       pin 177 */
+};
+
+const ubyte1 BOARD_pwd_channels[WHEEL_NUM_CHANNELS] =
+{
+    IO_PWD_02,  /* WHEEL_IDX_AXLE_1, pin 116 */
+    IO_PWD_03   /* WHEEL_IDX_AXLE_2, pin 140 */
+};
+
+/**************************************************************************************************
+ * Default map: HY-TTC 580/540/520/510 (both generations) and 590/590E
+ *
+ * This is the wiring every harness so far has used; the tables are byte-for-byte what the
+ * modules carried inline before the board layer existed.
+ *************************************************************************************************/
+#else
+
+const BOARD_ADC_CHANNEL BOARD_adc_channels[ADC_SCAN_NUM_CHANNELS] =
+{
+    { IO_ADC_00, IO_ADC_CURRENT,  IO_ADC_NO_RANGE,  IO_ADC_NO_PULL },   /* AI_103 */
+    { IO_ADC_01, IO_ADC_CURRENT,  IO_ADC_NO_RANGE,  IO_ADC_NO_PULL },   /* AI_127 */
+    { IO_ADC_02, IO_ADC_CURRENT,  IO_ADC_NO_RANGE,  IO_ADC_NO_PULL },   /* AI_104 */
+    { IO_ADC_03, IO_ADC_CURRENT,  IO_ADC_NO_RANGE,  IO_ADC_NO_PULL },   /* AI_128 */
+    { IO_ADC_04, IO_ADC_ABSOLUTE, IO_ADC_RANGE_10V, IO_ADC_NO_PULL },   /* AI_105 */
+    { IO_ADC_05, IO_ADC_ABSOLUTE, IO_ADC_RANGE_10V, IO_ADC_NO_PULL },   /* AI_129 */
+    { IO_ADC_06, IO_ADC_ABSOLUTE, IO_ADC_RANGE_10V, IO_ADC_NO_PULL },   /* AI_106 */
+    { IO_ADC_07, IO_ADC_ABSOLUTE, IO_ADC_RANGE_10V, IO_ADC_NO_PULL },   /* AI_130 */
+    { IO_ADC_08, IO_ADC_ABSOLUTE, IO_ADC_RANGE_10V, IO_ADC_NO_PULL },   /* AI_107 */
+    { IO_ADC_09, IO_ADC_ABSOLUTE, IO_ADC_RANGE_10V, IO_ADC_NO_PULL }    /* AI_131 */
+};
+
+const BOARD_DI_CHANNEL BOARD_di_channels[DI_SCAN_NUM_CHANNELS] =
+{
+    { IO_DI_58, IO_DI_PU_10K },     /* bit 0,  DI_108 */
+    { IO_DI_59, IO_DI_PU_10K },     /* bit 1,  DI_132 */
+    { IO_DI_60, IO_DI_PU_10K },     /* bit 2,  DI_109 */
+    { IO_DI_61, IO_DI_PU_10K },     /* bit 3,  DI_133 */
+    { IO_DI_62, IO_DI_PU_10K },     /* bit 4,  DI_110 */
+    { IO_DI_63, IO_DI_PU_10K },     /* bit 5,  DI_134 */
+    { IO_DI_64, IO_DI_PU_10K },     /* bit 6,  DI_111 */
+    { IO_DI_65, IO_DI_PU_10K },     /* bit 7,  DI_135 */
+    { IO_DI_66, IO_DI_PU_10K },     /* bit 8,  DI_112 */
+    { IO_DI_67, IO_DI_PU_10K },     /* bit 9,  DI_136 */
+    { IO_DI_68, IO_DI_PU_10K }      /* bit 10, DI_113 */
+};
+
+const ubyte1 BOARD_do_channels[DO_OUT_NUM_CHANNELS] =
+{
+    IO_DO_16,   /* DO_OUT_BSKR_COIL_1 */
+    IO_DO_17,   /* DO_OUT_BSKR_COIL_2 */
+    IO_DO_18    /* DO_OUT_BSKR_COIL_3 */
+};
+
+const ubyte1 BOARD_pwm_channels[PWM_OUT_NUM_CHANNELS] =
+{
+    IO_PWM_03,  /* PWM_OUT_IDX_TED_RELAY */
+    IO_PWM_04   /* PWM_OUT_IDX_FAN       */
+};
+
+const ubyte1 BOARD_pwd_channels[WHEEL_NUM_CHANNELS] =
+{
+    IO_PWD_00,  /* WHEEL_IDX_AXLE_1 */
+    IO_PWD_01   /* WHEEL_IDX_AXLE_2 */
+};
+
+#endif
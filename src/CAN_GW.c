@@ -0,0 +1,59 @@
+/**************************************************************************************************
+ * Name
+ *    CAN_GW.c
+ *
+ * Purpose
+ *    Table-driven CAN gateway engine, see CAN_GW.h.
+ *************************************************************************************************/
+
+#include "CAN_GW.h"
+
+static ubyte4 can_gw_unrouted;
+
+ubyte1 CAN_GW_Process(const CAN_GW_ROUTE * const routes,
+                      ubyte1 route_count,
+                      IO_CAN_DATA_FRAME * const frames,
+                      ubyte1 frame_count,
+                      ubyte4 arrival_stamp)
+{
+    ubyte1 forwarded = 0;
+    ubyte1 i;
+
+    for (i = 0; i < frame_count; i++)
+    {
+        IO_CAN_DATA_FRAME * frame = &frames[i];
+        ubyte1 r;
+
+        for (r = 0; r < route_count; r++)
+        {
+            const CAN_GW_ROUTE * route = &routes[r];
+
+            if ((frame->id & route->match_mask) == route->match_id)
+            {
+                /* rewrite in place, the only copy is the enqueue itself */
+                if (route->rewrite_id != CAN_GW_KEEP_ID)
+                {
+                    frame->id = route->rewrite_id;
+                }
+                if (route->rewrite_format != CAN_GW_KEEP_FORMAT)
+                {
+                    frame->id_format = route->rewrite_format;
+                }
+                (void)CAN_TX_EnqueueStamped(*route->dst_handle, frame,
+                                            arrival_stamp, route->prof_section);
+                forwarded++;
+                break;  /* first matching route wins */
+            }
+        }
+        if (r == route_count)
+        {
+            can_gw_unrouted++;
+        }
+    }
+    return forwarded;
+}
+
+ubyte4 CAN_GW_UnroutedFrames(void)
+{
+    return can_gw_unrouted;
+}
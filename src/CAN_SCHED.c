@@ -0,0 +1,123 @@
+/**************************************************************************************************
+ * Name
+ *    CAN_SCHED.c
+ *
+ * Purpose
+ *    Deadline-aware transmit scheduling on top of the CAN_TX queues, see CAN_SCHED.h.
+ *************************************************************************************************/
+
+#include "CAN_SCHED.h"
+#include "CAN_TX.h"
+
+/**************************************************************************************************
+ * Static data
+ *************************************************************************************************/
+
+typedef struct can_sched_msg_
+{
+    ubyte2 handle;              /* CAN_TX write handle                      */
+    ubyte4 id;                  /* identifier for priority ordering         */
+    ubyte2 period_ms;
+    ubyte2 phase_ms;
+    ubyte2 deadline_ms;
+    CAN_SCHED_PACK_FN pack;
+    bool   released;            /* due but not yet handed to CAN_TX         */
+    ubyte4 release_tick;        /* tick of the pending release              */
+    bool   missed;              /* this release already counted as missed   */
+} CAN_SCHED_MSG;
+
+static CAN_SCHED_MSG can_sched_msgs[CAN_SCHED_MAX_MSGS];
+static ubyte1 can_sched_num_msgs;
+static ubyte4 can_sched_misses;
+
+/**************************************************************************************************
+ * Functions
+ *************************************************************************************************/
+
+void CAN_SCHED_Init(void)
+{
+    can_sched_num_msgs = 0;
+    can_sched_misses   = 0;
+}
+
+IO_ErrorType CAN_SCHED_Add(ubyte2 handle,
+                           ubyte4 id,
+                           ubyte2 period_ms,
+                           ubyte2 phase_ms,
+                           ubyte2 deadline_ms,
+                           CAN_SCHED_PACK_FN pack)
+{
+    CAN_SCHED_MSG * msg;
+
+    if (can_sched_num_msgs >= CAN_SCHED_MAX_MSGS)
+    {
+        return IO_E_CAN_MAX_HANDLES_REACHED;
+    }
+    msg = &can_sched_msgs[can_sched_num_msgs];
+    msg->handle      = handle;
+    msg->id          = id;
+    msg->period_ms   = period_ms;
+    msg->phase_ms    = phase_ms;
+    msg->deadline_ms = deadline_ms;
+    msg->pack        = pack;
+    msg->released    = FALSE;
+    msg->missed      = FALSE;
+    can_sched_num_msgs++;
+    return IO_E_OK;
+}
+
+void CAN_SCHED_Service(ubyte4 tick_ms)
+{
+    CAN_SCHED_MSG * next = NULL;
+    ubyte1 i;
+
+    for (i = 0; i < can_sched_num_msgs; i++)
+    {
+        CAN_SCHED_MSG * msg = &can_sched_msgs[i];
+
+        /* release on the phase tick of each period */
+        if ((tick_ms % msg->period_ms) == msg->phase_ms)
+        {
+            if (msg->released != FALSE)
+            {
+                /* previous release never made it out: that deadline is gone for good */
+                can_sched_misses++;
+            }
+            msg->released     = TRUE;
+            msg->release_tick = tick_ms;
+            msg->missed       = FALSE;
+        }
+
+        if (msg->released != FALSE)
+        {
+            if (((tick_ms - msg->release_tick) > msg->deadline_ms) && (msg->missed == FALSE))
+            {
+                can_sched_misses++;
+                msg->missed = TRUE;     /* count once, keep trying to send */
+            }
+            /* lowest identifier wins, like bus arbitration */
+            if ((next == NULL) || (msg->id < next->id))
+            {
+                next = msg;
+            }
+        }
+    }
+
+    /* one frame per tick keeps the load shaped even when several messages line up */
+    if (next != NULL)
+    {
+        IO_CAN_DATA_FRAME frame = {0};
+
+        next->pack(&frame);
+        if (CAN_TX_Enqueue(next->handle, &frame) == IO_E_OK)
+        {
+            next->released = FALSE;
+        }
+        /* ring full: stay released, retry next tick */
+    }
+}
+
+ubyte4 CAN_SCHED_DeadlineMisses(void)
+{
+    return can_sched_misses;
+}
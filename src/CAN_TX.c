@@ -0,0 +1,149 @@
+/**************************************************************************************************
+ * Name
+ *    CAN_TX.c
+ *
+ * Purpose
+ *    Software transmit queue over IO_CAN_WriteMsg()/IO_CAN_MsgStatus(), see CAN_TX.h.
+ *************************************************************************************************/
+
+#include "CAN_TX.h"
+#include "MPU_GUARD.h"
+#include "PROF.h"
+
+/**************************************************************************************************
+ * Static data
+ *************************************************************************************************/
+
+typedef struct can_tx_entry_
+{
+    IO_CAN_DATA_FRAME frame;
+    ubyte4            arrival_stamp;                /* IO_RTC_StartTime() stamp              */
+    ubyte1            prof_section;                 /* latency section or CAN_TX_NO_PROF     */
+} CAN_TX_ENTRY;
+
+typedef struct can_tx_queue_
+{
+    ubyte2            handle;                       /* write handle from IO_CAN_ConfigMsg()  */
+    ubyte1            head;                         /* next frame to transmit                */
+    ubyte1            tail;                         /* next free slot                        */
+    CAN_TX_ENTRY      ring[CAN_TX_QUEUE_DEPTH];     /* pending frames                        */
+} CAN_TX_QUEUE;
+
+MPU_GUARD_DATA(can_tx_queues)
+static CAN_TX_QUEUE can_tx_queues[CAN_TX_MAX_QUEUES];
+static ubyte1 can_tx_queue_count;
+static ubyte4 can_tx_dropped;
+
+/* ring indices run free and are masked on access, DEPTH must be a power of two */
+#define CAN_TX_RING_MASK    ((ubyte1)(CAN_TX_QUEUE_DEPTH - 1))
+#define CAN_TX_RING_USED(q) ((ubyte1)((q)->tail - (q)->head))
+
+/**************************************************************************************************
+ * Functions
+ *************************************************************************************************/
+
+void CAN_TX_Init(void)
+{
+    ubyte1 i;
+
+    for (i = 0; i < CAN_TX_MAX_QUEUES; i++)
+    {
+        can_tx_queues[i].handle = 0;
+        can_tx_queues[i].head   = 0;
+        can_tx_queues[i].tail   = 0;
+    }
+    can_tx_queue_count = 0;
+    can_tx_dropped     = 0;
+}
+
+static CAN_TX_QUEUE * CAN_TX_FindQueue(ubyte2 handle)
+{
+    ubyte1 i;
+
+    for (i = 0; i < can_tx_queue_count; i++)
+    {
+        if (can_tx_queues[i].handle == handle)
+        {
+            return &can_tx_queues[i];
+        }
+    }
+    return NULL;
+}
+
+IO_ErrorType CAN_TX_Register(ubyte2 handle)
+{
+    if (can_tx_queue_count >= CAN_TX_MAX_QUEUES)
+    {
+        return IO_E_CAN_MAX_HANDLES_REACHED;
+    }
+    can_tx_queues[can_tx_queue_count].handle = handle;
+    can_tx_queues[can_tx_queue_count].head   = 0;
+    can_tx_queues[can_tx_queue_count].tail   = 0;
+    can_tx_queue_count++;
+    return IO_E_OK;
+}
+
+IO_ErrorType CAN_TX_Enqueue(ubyte2 handle, const IO_CAN_DATA_FRAME * const frame)
+{
+    return CAN_TX_EnqueueStamped(handle, frame, 0, CAN_TX_NO_PROF);
+}
+
+IO_ErrorType CAN_TX_EnqueueStamped(ubyte2 handle,
+                                   const IO_CAN_DATA_FRAME * const frame,
+                                   ubyte4 arrival_stamp,
+                                   ubyte1 prof_section)
+{
+    CAN_TX_QUEUE * queue = CAN_TX_FindQueue(handle);
+    CAN_TX_ENTRY * entry;
+
+    if (queue == NULL)
+    {
+        return IO_E_CAN_WRONG_HANDLE;
+    }
+    if (CAN_TX_RING_USED(queue) >= CAN_TX_QUEUE_DEPTH)
+    {
+        can_tx_dropped++;
+        return IO_E_BUSY;
+    }
+    entry = &queue->ring[queue->tail & CAN_TX_RING_MASK];
+    entry->frame         = *frame;
+    entry->arrival_stamp = arrival_stamp;
+    entry->prof_section  = prof_section;
+    queue->tail++;
+    return IO_E_OK;
+}
+
+void CAN_TX_Service(void)
+{
+    ubyte1 i;
+
+    for (i = 0; i < can_tx_queue_count; i++)
+    {
+        CAN_TX_QUEUE * queue = &can_tx_queues[i];
+
+        /* push frames into the message object as long as it reports free,
+         * stop at the first busy status instead of waiting for it */
+        while (CAN_TX_RING_USED(queue) > 0)
+        {
+            CAN_TX_ENTRY * entry = &queue->ring[queue->head & CAN_TX_RING_MASK];
+
+            if (IO_CAN_MsgStatus(queue->handle) != IO_E_OK)
+            {
+                break;
+            }
+            (void)IO_CAN_WriteMsg(queue->handle, &entry->frame);
+            if (entry->prof_section != CAN_TX_NO_PROF)
+            {
+                /* end-to-end latency: stamped at reception, sampled at the handover */
+                PROF_Sample(entry->prof_section,
+                            IO_RTC_GetTimeUS(entry->arrival_stamp));
+            }
+            queue->head++;
+        }
+    }
+}
+
+ubyte4 CAN_TX_DroppedFrames(void)
+{
+    return can_tx_dropped;
+}
@@ -0,0 +1,467 @@
+/**************************************************************************************************
+ * Name
+ *    CONS.c
+ *
+ * Purpose
+ *    Serial diagnostics console, see CONS.h.
+ *************************************************************************************************/
+
+#include "CONS.h"
+#include "CAN_GW.h"
+#include "CAN_SCHED.h"
+#include "CAN_TX.h"
+#include "DIAG_LOG.h"
+#include "FLREC.h"
+#include "J1939.h"
+#include "ODO.h"
+#include "PARAM.h"
+#include "PROF.h"
+#include "SCHED.h"
+#include "TELEM.h"
+
+/**************************************************************************************************
+ * Static data
+ *************************************************************************************************/
+
+/* output ring, indices run free and are masked on access (see CAN_TX.c) */
+#define CONS_TX_RING_MASK   ((ubyte2)(CONS_TX_RING_SIZE - 1))
+
+static ubyte1 cons_tx_ring[CONS_TX_RING_SIZE];
+static ubyte2 cons_tx_head;         /* next byte to hand to the driver      */
+static ubyte2 cons_tx_tail;         /* next free slot                       */
+static ubyte4 cons_tx_dropped;
+
+static ubyte1 cons_line[CONS_LINE_SIZE];
+static ubyte1 cons_line_len;
+static bool   cons_line_overrun;    /* discard input up to the terminator   */
+
+/* incremental dump state: which dump runs and the next item to format */
+#define CONS_DUMP_NONE      0
+#define CONS_DUMP_PAR       1
+#define CONS_DUMP_PROF      2
+#define CONS_DUMP_STAT      3
+#define CONS_DUMP_ODO       4
+static ubyte1 cons_dump_kind;
+static ubyte1 cons_dump_index;
+
+static bool cons_ready;
+
+static const char * const cons_param_names[PARAM_NUM_PARAMS] =
+{
+    "kp", "ki", "kd"
+};
+
+static const char * const cons_odo_names[ODO_NUM_COUNTERS] =
+{
+    "seconds", "ted_engage", "safestate", "spare"
+};
+
+static const char * const cons_prof_names[PROF_NUM_SECTIONS] =
+{
+    "sensors", "torque", "can1", "can2", "boot", "gw_m", "gw_e", "gw_t"
+};
+
+/* counters for the stat dump, one line per entry */
+typedef struct cons_counter_
+{
+    const char * name;
+    ubyte4 (* read)(void);
+} CONS_COUNTER;
+
+static const CONS_COUNTER cons_counters[] =
+{
+    { "sched_overruns",  &SCHED_OverrunTicks       },
+    { "cantx_dropped",   &CAN_TX_DroppedFrames     },
+    { "sched_deadline",  &CAN_SCHED_DeadlineMisses },
+    { "gw_unrouted",     &CAN_GW_UnroutedFrames    },
+    { "j1939_aborted",   &J1939_AbortedSessions    },
+    { "flrec_dropped",   &FLREC_DroppedBuffers     },
+    { "telem_dropped",   &TELEM_DroppedPackets     },
+    { "diag_dropped",    &DIAG_LOG_DroppedEvents   },
+    { "cons_dropped",    &CONS_DroppedBytes        },
+    { "odo_commits",     &ODO_Commits              },
+};
+#define CONS_COUNTER_COUNT ((ubyte1)(sizeof(cons_counters)/sizeof(cons_counters[0])))
+
+/**************************************************************************************************
+ * Local functions: ring output and formatting
+ *************************************************************************************************/
+
+#define CONS_TX_USED()      ((ubyte2)(cons_tx_tail - cons_tx_head))
+#define CONS_TX_FREE()      ((ubyte2)(CONS_TX_RING_SIZE - CONS_TX_USED()))
+
+static void CONS_PutChar(ubyte1 c)
+{
+    if (CONS_TX_FREE() == 0u)
+    {
+        cons_tx_dropped++;
+        return;
+    }
+    cons_tx_ring[cons_tx_tail & CONS_TX_RING_MASK] = c;
+    cons_tx_tail++;
+}
+
+static void CONS_PutStr(const char * s)
+{
+    while (*s != '\0')
+    {
+        CONS_PutChar((ubyte1)*s);
+        s++;
+    }
+}
+
+static void CONS_PutEol(void)
+{
+    CONS_PutStr("\r\n");
+}
+
+/* unsigned decimal, no leading zeros */
+static void CONS_PutDec(ubyte4 value)
+{
+    ubyte1 digits[10];
+    ubyte1 n = 0;
+
+    do
+    {
+        digits[n] = (ubyte1)('0' + (value % 10u));
+        value /= 10u;
+        n++;
+    } while (value != 0u);
+
+    while (n > 0u)
+    {
+        n--;
+        CONS_PutChar(digits[n]);
+    }
+}
+
+/* fixed-width 16 bit hexadecimal (histograms line up in columns) */
+static void CONS_PutHex16(ubyte2 value)
+{
+    static const char hex[] = "0123456789abcdef";
+    sbyte1 shift;
+
+    for (shift = 12; shift >= 0; shift -= 4)
+    {
+        CONS_PutChar((ubyte1)hex[(value >> shift) & 0xFu]);
+    }
+}
+
+/**************************************************************************************************
+ * Local functions: incremental dumps
+ *************************************************************************************************/
+
+/* worst-case bytes of one dump item; the next item is only formatted when the
+ * ring can take it whole, so items never tear. The largest item is a profiler
+ * section: stats line (up to ~54 bytes with a 10-digit mean) plus the
+ * histogram line of 6 + 16*5 + 2 = 88 bytes, 142 in total */
+#define CONS_ITEM_RESERVE   160
+
+/* one item per call, returns TRUE when the dump is finished */
+static bool CONS_DumpParam(ubyte1 index)
+{
+    if (index >= PARAM_NUM_PARAMS)
+    {
+        return TRUE;
+    }
+    CONS_PutDec(index);
+    CONS_PutStr("  ");
+    CONS_PutStr(cons_param_names[index]);
+    CONS_PutStr(" = ");
+    CONS_PutDec(PARAM_Get(index));
+    CONS_PutEol();
+    return FALSE;
+}
+
+static bool CONS_DumpProf(ubyte1 index)
+{
+    const PROF_STATS * stats;
+    ubyte1 bin;
+
+    if (index >= PROF_NUM_SECTIONS)
+    {
+        return TRUE;
+    }
+    stats = PROF_GetStats(index);
+    CONS_PutStr(cons_prof_names[index]);
+    CONS_PutStr("  min ");
+    CONS_PutDec((stats->count > 0u) ? stats->min_us : 0u);
+    CONS_PutStr(" max ");
+    CONS_PutDec(stats->max_us);
+    CONS_PutStr(" mean ");
+    CONS_PutDec((stats->count > 0u) ? (stats->sum_us / stats->count) : 0u);
+    CONS_PutStr(" n ");
+    CONS_PutDec(stats->count);
+    CONS_PutEol();
+
+    CONS_PutStr("  hist");
+    for (bin = 0; bin < PROF_HIST_BINS; bin++)
+    {
+        CONS_PutChar((ubyte1)' ');
+        CONS_PutHex16(stats->hist[bin]);
+    }
+    CONS_PutEol();
+    return FALSE;
+}
+
+static bool CONS_DumpOdo(ubyte1 index)
+{
+    if (index >= ODO_NUM_COUNTERS)
+    {
+        return TRUE;
+    }
+    CONS_PutStr(cons_odo_names[index]);
+    CONS_PutStr(" = ");
+    CONS_PutDec(ODO_Get(index));
+    CONS_PutEol();
+    return FALSE;
+}
+
+static bool CONS_DumpStat(ubyte1 index)
+{
+    if (index >= CONS_COUNTER_COUNT)
+    {
+        return TRUE;
+    }
+    CONS_PutStr(cons_counters[index].name);
+    CONS_PutStr(" = ");
+    CONS_PutDec(cons_counters[index].read());
+    CONS_PutEol();
+    return FALSE;
+}
+
+static void CONS_DumpStep(void)
+{
+    bool done;
+
+    if (cons_dump_kind == CONS_DUMP_NONE)
+    {
+        return;
+    }
+    if (CONS_TX_FREE() < CONS_ITEM_RESERVE)
+    {
+        return;     /* ring too full, continue once the line caught up */
+    }
+
+    switch (cons_dump_kind)
+    {
+        case CONS_DUMP_PAR:
+            done = CONS_DumpParam(cons_dump_index);
+            break;
+        case CONS_DUMP_PROF:
+            done = CONS_DumpProf(cons_dump_index);
+            break;
+        case CONS_DUMP_ODO:
+            done = CONS_DumpOdo(cons_dump_index);
+            break;
+        default:
+            done = CONS_DumpStat(cons_dump_index);
+            break;
+    }
+
+    if (done != FALSE)
+    {
+        cons_dump_kind = CONS_DUMP_NONE;
+        CONS_PutStr("> ");
+    }
+    else
+    {
+        cons_dump_index++;
+    }
+}
+
+/**************************************************************************************************
+ * Local functions: command parsing
+ *************************************************************************************************/
+
+static bool CONS_LineIs(const char * cmd)
+{
+    ubyte1 i;
+
+    for (i = 0; i < cons_line_len; i++)
+    {
+        if ((cmd[i] == '\0') || ((ubyte1)cmd[i] != cons_line[i]))
+        {
+            return FALSE;
+        }
+    }
+    return (bool)(cmd[cons_line_len] == '\0');
+}
+
+static void CONS_Execute(void)
+{
+    if (cons_line_len == 0u)
+    {
+        CONS_PutStr("> ");
+        return;
+    }
+    if (cons_dump_kind != CONS_DUMP_NONE)
+    {
+        return;     /* one dump at a time, input during a dump is dropped */
+    }
+
+    if (CONS_LineIs("par") != FALSE)
+    {
+        cons_dump_kind = CONS_DUMP_PAR;
+    }
+    else if (CONS_LineIs("prof") != FALSE)
+    {
+        cons_dump_kind = CONS_DUMP_PROF;
+    }
+    else if (CONS_LineIs("stat") != FALSE)
+    {
+        cons_dump_kind = CONS_DUMP_STAT;
+    }
+    else if (CONS_LineIs("odo") != FALSE)
+    {
+        cons_dump_kind = CONS_DUMP_ODO;
+    }
+    else if (CONS_LineIs("help") != FALSE)
+    {
+        CONS_PutStr("par prof stat odo help");
+        CONS_PutEol();
+        CONS_PutStr("> ");
+        return;
+    }
+    else
+    {
+        CONS_PutStr("?");
+        CONS_PutEol();
+        CONS_PutStr("> ");
+        return;
+    }
+    cons_dump_index = 0;
+}
+
+static void CONS_Receive(void)
+{
+    ubyte1 chunk[CONS_RX_CHUNK];
+    ubyte2 rx_len = 0;
+    ubyte2 i;
+
+    if (IO_UART_Read(chunk, sizeof(chunk), &rx_len) != IO_E_OK)
+    {
+        return;     /* reception errors surface via IO_UART_GetRxStatus diagnostics */
+    }
+
+    for (i = 0; i < rx_len; i++)
+    {
+        ubyte1 c = chunk[i];
+
+        if ((c == (ubyte1)'\r') || (c == (ubyte1)'\n'))
+        {
+            CONS_PutEol();
+            if (cons_line_overrun == FALSE)
+            {
+                CONS_Execute();
+            }
+            else
+            {
+                CONS_PutStr("?");
+                CONS_PutEol();
+                CONS_PutStr("> ");
+            }
+            cons_line_len     = 0;
+            cons_line_overrun = FALSE;
+        }
+        else if (cons_line_len < CONS_LINE_SIZE)
+        {
+            cons_line[cons_line_len] = c;
+            cons_line_len++;
+            CONS_PutChar(c);    /* echo */
+        }
+        else
+        {
+            cons_line_overrun = TRUE;
+        }
+    }
+}
+
+/* hands ring content to the driver, sized to the free transmit buffer space */
+static void CONS_Transmit(void)
+{
+    ubyte2 pending = 0;
+    ubyte2 budget;
+    ubyte2 contiguous;
+    ubyte2 written = 0;
+
+    if (CONS_TX_USED() == 0u)
+    {
+        return;
+    }
+    if (IO_UART_GetTxStatus(&pending) != IO_E_OK)
+    {
+        return;
+    }
+    budget = (ubyte2)(IO_UART_BUFFER_LEN - pending);
+
+    while ((budget > 0u) && (CONS_TX_USED() > 0u))
+    {
+        /* at most up to the ring wrap point per write, the rest goes next iteration */
+        contiguous = (ubyte2)(CONS_TX_RING_SIZE - (cons_tx_head & CONS_TX_RING_MASK));
+        if (contiguous > CONS_TX_USED())
+        {
+            contiguous = CONS_TX_USED();
+        }
+        if (contiguous > budget)
+        {
+            contiguous = budget;
+        }
+        if (IO_UART_Write(&cons_tx_ring[cons_tx_head & CONS_TX_RING_MASK],
+                          contiguous, &written) != IO_E_OK)
+        {
+            break;
+        }
+        cons_tx_head = (ubyte2)(cons_tx_head + written);
+        budget       = (ubyte2)(budget - written);
+        if (written < contiguous)
+        {
+            break;  /* driver took less than offered, try again next call */
+        }
+    }
+}
+
+/**************************************************************************************************
+ * Functions
+ *************************************************************************************************/
+
+IO_ErrorType CONS_Init(void)
+{
+    IO_ErrorType io_error;
+
+    cons_tx_head      = 0;
+    cons_tx_tail      = 0;
+    cons_tx_dropped   = 0;
+    cons_line_len     = 0;
+    cons_line_overrun = FALSE;
+    cons_dump_kind    = CONS_DUMP_NONE;
+    cons_dump_index   = 0;
+    cons_ready        = FALSE;
+
+    io_error = IO_UART_Init(CONS_BAUDRATE,
+                            8,                      /* data bits */
+                            IO_UART_PARITY_NONE,
+                            1);                     /* stop bits */
+    if (io_error == IO_E_OK)
+    {
+        cons_ready = TRUE;
+        CONS_PutStr("> ");
+    }
+    return io_error;
+}
+
+void CONS_Task(void)
+{
+    if (cons_ready == FALSE)
+    {
+        return;
+    }
+    CONS_Receive();
+    CONS_DumpStep();
+    CONS_Transmit();
+}
+
+ubyte4 CONS_DroppedBytes(void)
+{
+    return cons_tx_dropped;
+}
@@ -0,0 +1,102 @@
+/**************************************************************************************************
+ * Name
+ *    DIAG_LOG.c
+ *
+ * Purpose
+ *    Lock-free diagnostic event ring between the error callbacks and the main loop,
+ *    see DIAG_LOG.h.
+ *************************************************************************************************/
+
+#include "DIAG_LOG.h"
+#include "CAN_TX.h"
+#include "SCHED.h"
+#include "MPU_GUARD.h"
+
+/**************************************************************************************************
+ * Defines
+ *************************************************************************************************/
+
+#define DIAG_LOG_MASK           (DIAG_LOG_DEPTH - 1)
+
+/* events handed to CAN_TX per report call, keeps the burst bounded */
+#define DIAG_LOG_MAX_PER_REPORT 4
+
+/**************************************************************************************************
+ * Static data
+ *************************************************************************************************/
+
+MPU_GUARD_DATA(diag_log_ring)
+static DIAG_LOG_ENTRY diag_log_ring[DIAG_LOG_DEPTH];
+static volatile ubyte4 diag_log_head;   /* written by the callback context only */
+static volatile ubyte4 diag_log_tail;   /* written by the main loop only        */
+static volatile ubyte4 diag_log_dropped;
+
+/**************************************************************************************************
+ * Functions
+ *************************************************************************************************/
+
+void DIAG_LOG_Init(void)
+{
+    diag_log_head    = 0;
+    diag_log_tail    = 0;
+    diag_log_dropped = 0;
+}
+
+void DIAG_LOG_Record(ubyte1 source,
+                     ubyte1 diag_state,
+                     const DIAG_ERRORCODE * const error)
+{
+    ubyte4 head = diag_log_head;
+    DIAG_LOG_ENTRY * entry;
+
+    if ((head - diag_log_tail) >= DIAG_LOG_DEPTH)
+    {
+        diag_log_dropped++;     /* full: dropping is cheaper than blocking here */
+        return;
+    }
+    entry = &diag_log_ring[head & DIAG_LOG_MASK];
+    entry->tick         = SCHED_GetTick();      /* plain RAM read, no driver call */
+    entry->source       = source;
+    entry->diag_state   = diag_state;
+    entry->error_code   = error->error_code;
+    entry->device_num   = error->device_num;
+    entry->faulty_value = error->faulty_value;
+
+    /* publish after the entry is complete */
+    diag_log_head = head + 1;
+}
+
+void DIAG_LOG_Report(ubyte2 handle)
+{
+    ubyte1 emitted = 0;
+
+    while (((diag_log_head - diag_log_tail) > 0) && (emitted < DIAG_LOG_MAX_PER_REPORT))
+    {
+        const DIAG_LOG_ENTRY * entry = &diag_log_ring[diag_log_tail & DIAG_LOG_MASK];
+        IO_CAN_DATA_FRAME frame = {0};
+
+        frame.id        = DIAG_LOG_REPORT_ID;
+        frame.id_format = IO_CAN_STD_FRAME;
+        frame.length    = 8;
+        frame.data[0]   = entry->error_code;
+        frame.data[1]   = entry->device_num;
+        frame.data[2]   = entry->source;
+        frame.data[3]   = entry->diag_state;
+        frame.data[4]   = (ubyte1)(entry->faulty_value >> 24);
+        frame.data[5]   = (ubyte1)(entry->faulty_value >> 16);
+        frame.data[6]   = (ubyte1)(entry->faulty_value >> 8);
+        frame.data[7]   = (ubyte1)(entry->faulty_value >> 0);
+
+        if (CAN_TX_Enqueue(handle, &frame) != IO_E_OK)
+        {
+            break;      /* TX ring full, retry next report cycle */
+        }
+        diag_log_tail++;
+        emitted++;
+    }
+}
+
+ubyte4 DIAG_LOG_DroppedEvents(void)
+{
+    return diag_log_dropped;
+}
@@ -0,0 +1,92 @@
+/**************************************************************************************************
+ * Name
+ *    DI_SCAN.c
+ *
+ * Purpose
+ *    Batched acquisition of all digital inputs into one packed word, see DI_SCAN.h.
+ *************************************************************************************************/
+
+#include "DI_SCAN.h"
+#include "BOARD.h"
+
+/**************************************************************************************************
+ * Static data
+ *************************************************************************************************/
+
+/* pin assignments come from the board layer (BOARD_di_channels),
+ * scan order == bit position in the packed word */
+
+static ubyte4 di_scan_raw;
+static ubyte4 di_scan_state;
+static ubyte1 di_scan_counter[DI_SCAN_NUM_CHANNELS];
+
+/**************************************************************************************************
+ * Functions
+ *************************************************************************************************/
+
+IO_ErrorType DI_SCAN_Init(void)
+{
+    IO_ErrorType io_error = IO_E_OK;
+    ubyte1 i;
+
+    for (i = 0; i < DI_SCAN_NUM_CHANNELS; i++)
+    {
+        IO_ErrorType channel_error;
+
+        channel_error = IO_DI_Init(BOARD_di_channels[i].channel,
+                                   BOARD_di_channels[i].pupd,
+                                   NULL);
+        if (channel_error != IO_E_OK)
+        {
+            io_error = channel_error;   /* report the last failing channel */
+        }
+        di_scan_counter[i] = 0;
+    }
+    di_scan_raw   = 0;
+    di_scan_state = 0;
+    return io_error;
+}
+
+void DI_SCAN_Read(void)
+{
+    ubyte4 raw = 0;
+    ubyte1 i;
+
+    for (i = 0; i < DI_SCAN_NUM_CHANNELS; i++)
+    {
+        bool value = FALSE;
+        ubyte4 bit = (ubyte4)(1u << i);
+
+        (void)IO_DI_Get(BOARD_di_channels[i].channel, &value);
+        if (value != FALSE)
+        {
+            raw |= bit;
+        }
+
+        /* debounce: a bit flips only after DEBOUNCE_COUNT consecutive opposite samples */
+        if ((raw & bit) == (di_scan_state & bit))
+        {
+            di_scan_counter[i] = 0;
+        }
+        else
+        {
+            di_scan_counter[i]++;
+            if (di_scan_counter[i] >= DI_SCAN_DEBOUNCE_COUNT)
+            {
+                di_scan_state      ^= bit;
+                di_scan_counter[i]  = 0;
+            }
+        }
+    }
+    di_scan_raw = raw;
+}
+
+ubyte4 DI_SCAN_State(void)
+{
+    return di_scan_state;
+}
+
+ubyte4 DI_SCAN_Raw(void)
+{
+    return di_scan_raw;
+}
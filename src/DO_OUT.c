@@ -0,0 +1,96 @@
+/**************************************************************************************************
+ * Name
+ *    DO_OUT.c
+ *
+ * Purpose
+ *    Change-detection shadow over the digital outputs, see DO_OUT.h.
+ *************************************************************************************************/
+
+#include "DO_OUT.h"
+#include "BOARD.h"
+
+/**************************************************************************************************
+ * Static data
+ *************************************************************************************************/
+
+/* pin assignments come from the board layer (BOARD_do_channels) */
+
+static ubyte1 do_out_desired;       /* what the application wants           */
+static ubyte1 do_out_written;       /* what was last written to the driver  */
+static ubyte1 do_out_refresh_cnt;   /* flushes until the next forced rewrite */
+
+/**************************************************************************************************
+ * Functions
+ *************************************************************************************************/
+
+IO_ErrorType DO_OUT_Init(void)
+{
+    IO_ErrorType io_error = IO_E_OK;
+    ubyte1 i;
+
+    for (i = 0; i < DO_OUT_NUM_CHANNELS; i++)
+    {
+        IO_ErrorType channel_error;
+
+        channel_error = IO_DO_Init(BOARD_do_channels[i], FALSE, NULL);
+        if (channel_error != IO_E_OK)
+        {
+            io_error = channel_error;   /* report the last failing channel */
+        }
+    }
+    do_out_desired     = 0;
+    do_out_written     = 0;
+    do_out_refresh_cnt = DO_OUT_REFRESH_CYCLES;
+    return io_error;
+}
+
+void DO_OUT_Set(ubyte1 mask, bool value)
+{
+    if (value != FALSE)
+    {
+        do_out_desired |= mask;
+    }
+    else
+    {
+        do_out_desired &= (ubyte1)~mask;
+    }
+}
+
+IO_ErrorType DO_OUT_Flush(void)
+{
+    IO_ErrorType io_error = IO_E_OK;
+    ubyte1 changed;
+    ubyte1 i;
+
+    changed = (ubyte1)(do_out_desired ^ do_out_written);
+
+    /* forced refresh: pretend every bit changed so all channels get rewritten */
+    do_out_refresh_cnt--;
+    if (do_out_refresh_cnt == 0)
+    {
+        do_out_refresh_cnt = DO_OUT_REFRESH_CYCLES;
+        changed = DO_OUT_ALL;
+    }
+
+    if (changed == 0)
+    {
+        return IO_E_OK;     /* steady state: no driver call at all */
+    }
+
+    for (i = 0; i < DO_OUT_NUM_CHANNELS; i++)
+    {
+        if ((changed & (ubyte1)(1u << i)) != 0u)
+        {
+            IO_ErrorType channel_error;
+
+            channel_error = IO_DO_Set(BOARD_do_channels[i],
+                                      (bool)((do_out_desired & (ubyte1)(1u << i)) != 0u));
+            if (channel_error != IO_E_OK)
+            {
+                io_error = channel_error;
+            }
+        }
+    }
+    do_out_written = do_out_desired;
+    return io_error;
+}
@@ -0,0 +1,163 @@
+/**************************************************************************************************
+ * Name
+ *    FLREC.c
+ *
+ * Purpose
+ *    Flight recorder to external flash, see FLREC.h.
+ *************************************************************************************************/
+
+#include "FLREC.h"
+#include "MPU_GUARD.h"
+
+/**************************************************************************************************
+ * Static data
+ *************************************************************************************************/
+
+typedef struct flrec_buf_header_
+{
+    ubyte2 magic;       /* FLREC_BUF_MAGIC                        */
+    ubyte2 reserved;
+    ubyte4 sequence;    /* increments per flushed buffer          */
+} FLREC_BUF_HEADER;
+
+#define FLREC_RECORDS_PER_BUF \
+    ((FLREC_BUF_SIZE - sizeof(FLREC_BUF_HEADER)) / sizeof(FLREC_RECORD))
+
+typedef struct flrec_buf_
+{
+    FLREC_BUF_HEADER header;
+    FLREC_RECORD     records[FLREC_RECORDS_PER_BUF];
+} FLREC_BUF;
+
+MPU_GUARD_DATA(flrec_bufs)
+static FLREC_BUF flrec_bufs[2];
+static ubyte1 flrec_active;         /* buffer currently being filled          */
+static ubyte2 flrec_fill;           /* records in the active buffer           */
+static bool   flrec_flush_pending;  /* the other buffer waits for the flash   */
+static ubyte4 flrec_sequence;
+static ubyte4 flrec_dropped;
+
+static ubyte1 flrec_bank;           /* currently selected flash bank          */
+static ubyte4 flrec_write_off;      /* next write offset within the bank      */
+static ubyte4 flrec_erased_until;   /* flash below this offset is erased      */
+static bool   flrec_erase_running;  /* last issued operation was an erase     */
+
+/**************************************************************************************************
+ * Functions
+ *************************************************************************************************/
+
+IO_ErrorType FLREC_Init(void)
+{
+    IO_ErrorType io_error;
+
+    flrec_active        = 0;
+    flrec_fill          = 0;
+    flrec_flush_pending = FALSE;
+    flrec_sequence      = 0;
+    flrec_dropped       = 0;
+    flrec_bank          = 0;
+    flrec_write_off     = FLREC_REGION_START;
+    flrec_erased_until  = FLREC_REGION_START;
+    flrec_erase_running = FALSE;
+
+    io_error = IO_FLASH_Init();
+    if (io_error != IO_E_OK)
+    {
+        return io_error;
+    }
+    (void)IO_FLASH_BankSelect(flrec_bank);
+
+    /* kick off the first erase, FLREC_Task() continues from here */
+    if (IO_FLASH_BlockErase(flrec_erased_until) == IO_E_OK)
+    {
+        flrec_erase_running = TRUE;
+    }
+    return IO_E_OK;
+}
+
+void FLREC_Log(const FLREC_RECORD * const record)
+{
+    FLREC_BUF * buf = &flrec_bufs[flrec_active];
+
+    buf->records[flrec_fill] = *record;    /* the only per-cycle cost */
+    flrec_fill++;
+
+    if (flrec_fill >= FLREC_RECORDS_PER_BUF)
+    {
+        if (flrec_flush_pending != FALSE)
+        {
+            /* flash did not keep up: recycle the buffer, lose its content */
+            flrec_dropped++;
+        }
+        else
+        {
+            buf->header.magic    = FLREC_BUF_MAGIC;
+            buf->header.reserved = 0;
+            buf->header.sequence = flrec_sequence;
+            flrec_sequence++;
+            flrec_flush_pending  = TRUE;
+            flrec_active         = (ubyte1)(1 - flrec_active);
+        }
+        flrec_fill = 0;
+    }
+}
+
+/* advances write offset and rotates banks at the end of the region */
+static void FLREC_AdvanceWriteHead(void)
+{
+    flrec_write_off += FLREC_BUF_SIZE;
+    if (flrec_write_off >= FLREC_REGION_END)
+    {
+        flrec_bank = (ubyte1)((flrec_bank + 1) % FLREC_NUM_BANKS);
+        (void)IO_FLASH_BankSelect(flrec_bank);
+        flrec_write_off    = FLREC_REGION_START;
+        flrec_erased_until = FLREC_REGION_START;
+    }
+}
+
+void FLREC_Task(void)
+{
+    if (IO_FLASH_GetStatus() == IO_E_BUSY)
+    {
+        return;     /* erase or write still in flight */
+    }
+    if (flrec_erase_running != FALSE)
+    {
+        flrec_erase_running = FALSE;
+        flrec_erased_until += FLREC_BLOCK_SIZE;
+    }
+
+    /* a full buffer beats the pre-erase, but may only land on erased flash */
+    if ((flrec_flush_pending != FALSE)
+     && ((flrec_write_off + FLREC_BUF_SIZE) <= flrec_erased_until))
+    {
+        FLREC_BUF * buf = &flrec_bufs[1 - flrec_active];
+
+        /* the firmware staging service may have left its own bank selected */
+        (void)IO_FLASH_BankSelect(flrec_bank);
+        if (IO_FLASH_Write(flrec_write_off,
+                           sizeof(FLREC_BUF),
+                           (ubyte1 *)buf) == IO_E_OK)
+        {
+            flrec_flush_pending = FALSE;
+            FLREC_AdvanceWriteHead();
+        }
+        return;
+    }
+
+    /* pre-erase one block ahead of the write head */
+    if ((flrec_erased_until < FLREC_REGION_END)
+     && ((flrec_erased_until - flrec_write_off) < (2u * FLREC_BLOCK_SIZE)))
+    {
+        (void)IO_FLASH_BankSelect(flrec_bank);
+        if (IO_FLASH_BlockErase(flrec_erased_until) == IO_E_OK)
+        {
+            flrec_erase_running = TRUE;
+        }
+    }
+}
+
+ubyte4 FLREC_DroppedBuffers(void)
+{
+    return flrec_dropped;
+}
@@ -0,0 +1,208 @@
+/**************************************************************************************************
+ * Name
+ *    FWUP.c
+ *
+ * Purpose
+ *    Background firmware staging over Ethernet, see FWUP.h.
+ *************************************************************************************************/
+
+#include "FWUP.h"
+#include "IO_FLASH.h"
+
+/**************************************************************************************************
+ * Static data
+ *************************************************************************************************/
+
+static ubyte2 fwup_socket;
+static bool   fwup_ready;           /* socket created                               */
+
+static ubyte2 fwup_total_blocks;    /* announced image size, 0 = no transfer active */
+static ubyte2 fwup_next_seq;        /* next expected block                          */
+static bool   fwup_image_ready;
+static ubyte4 fwup_erased_until;    /* staging region is erased below this offset   */
+
+/* one datagram: header + payload, also the flash write buffer (the driver needs the
+ * data to stay stable while the asynchronous write runs) */
+static ubyte1 fwup_packet[FWUP_HEADER_SIZE + FWUP_PAYLOAD_SIZE];
+static bool   fwup_write_pending;   /* fwup_packet handed to the flash driver       */
+
+/**************************************************************************************************
+ * Local functions
+ *************************************************************************************************/
+
+/* CRC-16/CCITT, same polynomial as the EEPROM parameter block */
+static ubyte2 FWUP_Crc16(const ubyte1 * data, ubyte2 length)
+{
+    ubyte2 crc = 0xFFFF;
+    ubyte2 i;
+    ubyte1 bit;
+
+    for (i = 0; i < length; i++)
+    {
+        crc ^= (ubyte2)((ubyte2)data[i] << 8);
+        for (bit = 0; bit < 8; bit++)
+        {
+            if ((crc & 0x8000u) != 0u)
+            {
+                crc = (ubyte2)((crc << 1) ^ 0x1021u);
+            }
+            else
+            {
+                crc = (ubyte2)(crc << 1);
+            }
+        }
+    }
+    return crc;
+}
+
+static void FWUP_Ack(ubyte2 seq, ubyte1 status)
+{
+    ubyte1 ack[5];
+
+    ack[0] = 'F';
+    ack[1] = 'A';
+    ack[2] = (ubyte1)(seq >> 8);
+    ack[3] = (ubyte1)seq;
+    ack[4] = status;
+    (void)IO_UDP_WriteTo(fwup_socket, ack, sizeof(ack),
+                         FWUP_PORT, (const ubyte1 *)FWUP_UPDATER_IP);
+}
+
+/**************************************************************************************************
+ * Functions
+ *************************************************************************************************/
+
+IO_ErrorType FWUP_Init(void)
+{
+    IO_ErrorType io_error;
+
+    fwup_ready         = FALSE;
+    fwup_total_blocks  = 0;
+    fwup_next_seq      = 0;
+    fwup_image_ready   = FALSE;
+    fwup_erased_until  = FWUP_REGION_START;
+    fwup_write_pending = FALSE;
+
+    io_error = IO_UDP_CreateSocket(IO_UDP_READ,
+                                   FWUP_PORT,
+                                   (const ubyte1 *)FWUP_LOCAL_IP,
+                                   &fwup_socket);
+    if (io_error == IO_E_OK)
+    {
+        fwup_ready = TRUE;
+    }
+    return io_error;
+}
+
+void FWUP_Task(void)
+{
+    ubyte2 port = 0;
+    ubyte2 len  = 0;
+    ubyte2 seq;
+    ubyte2 total;
+    ubyte2 crc;
+    ubyte4 offset;
+
+    if (fwup_ready == FALSE)
+    {
+        return;
+    }
+
+    /* a previously staged block completes asynchronously */
+    if (fwup_write_pending != FALSE)
+    {
+        if (IO_FLASH_GetStatus() == IO_E_BUSY)
+        {
+            return;         /* flash still working, keep the packet buffer stable */
+        }
+        fwup_write_pending = FALSE;
+        FWUP_Ack((ubyte2)(fwup_next_seq - 1u), FWUP_ACK_OK);
+        if (fwup_next_seq >= fwup_total_blocks)
+        {
+            fwup_image_ready  = TRUE;   /* every block arrived with a good CRC */
+            fwup_total_blocks = 0;
+        }
+    }
+
+    /* at most one datagram per call: the service only uses cycle slack */
+    if (IO_UDP_Read(fwup_socket, &port, fwup_packet, &len, sizeof(fwup_packet)) != IO_E_OK)
+    {
+        return;
+    }
+    if ((len <= FWUP_HEADER_SIZE) || (fwup_packet[0] != 'F') || (fwup_packet[1] != 'W'))
+    {
+        return;             /* not a block datagram */
+    }
+    seq   = (ubyte2)(((ubyte2)fwup_packet[2] << 8) | fwup_packet[3]);
+    total = (ubyte2)(((ubyte2)fwup_packet[4] << 8) | fwup_packet[5]);
+    crc   = (ubyte2)(((ubyte2)fwup_packet[6] << 8) | fwup_packet[7]);
+
+    /* block 0 opens a new transfer */
+    if (seq == 0u)
+    {
+        if (((ubyte4)total * FWUP_PAYLOAD_SIZE) > (FWUP_REGION_END - FWUP_REGION_START))
+        {
+            FWUP_Ack(seq, FWUP_ACK_BAD_SEQ);    /* image does not fit the region */
+            return;
+        }
+        fwup_total_blocks = total;
+        fwup_next_seq     = 0;
+        fwup_image_ready  = FALSE;
+        fwup_erased_until = FWUP_REGION_START;
+    }
+    if ((fwup_total_blocks == 0u) || (seq != fwup_next_seq))
+    {
+        FWUP_Ack(seq, FWUP_ACK_BAD_SEQ);        /* strictly in-order protocol */
+        return;
+    }
+
+    /* incremental integrity check, bad blocks never reach the flash */
+    if (FWUP_Crc16(&fwup_packet[FWUP_HEADER_SIZE],
+                   (ubyte2)(len - FWUP_HEADER_SIZE)) != crc)
+    {
+        FWUP_Ack(seq, FWUP_ACK_BAD_CRC);
+        return;
+    }
+
+    if (IO_FLASH_GetStatus() == IO_E_BUSY)
+    {
+        FWUP_Ack(seq, FWUP_ACK_AGAIN);          /* flight recorder owns the flash right now */
+        return;
+    }
+    /* the flight recorder rotates banks, the staging region lives in FWUP_BANK only */
+    (void)IO_FLASH_BankSelect(FWUP_BANK);
+
+    /* erase ahead of the write head, one block at a time */
+    offset = FWUP_REGION_START + ((ubyte4)seq * FWUP_PAYLOAD_SIZE);
+    if ((offset + FWUP_PAYLOAD_SIZE) > fwup_erased_until)
+    {
+        if (IO_FLASH_BlockErase(fwup_erased_until) == IO_E_OK)
+        {
+            fwup_erased_until += FWUP_BLOCK_SIZE;
+        }
+        FWUP_Ack(seq, FWUP_ACK_AGAIN);          /* resend once the erase is done */
+        return;
+    }
+
+    if (IO_FLASH_Write(offset,
+                       (ubyte4)(len - FWUP_HEADER_SIZE),
+                       &fwup_packet[FWUP_HEADER_SIZE]) == IO_E_OK)
+    {
+        fwup_write_pending = TRUE;              /* acknowledged on completion */
+        fwup_next_seq++;
+    }
+    else
+    {
+        FWUP_Ack(seq, FWUP_ACK_AGAIN);
+    }
+}
+
+bool FWUP_ImageReady(void)
+{
+    return fwup_image_ready;
+}
+
+ubyte2 FWUP_StagedBlocks(void)
+{
+    return fwup_next_seq;
+}
@@ -0,0 +1,202 @@
+/**************************************************************************************************
+ * Name
+ *    J1939.c
+ *
+ * Purpose
+ *    Minimal J1939 layer for the extended-ID inverter messages, see J1939.h.
+ *************************************************************************************************/
+
+#include "J1939.h"
+
+/**************************************************************************************************
+ * Static data
+ *************************************************************************************************/
+
+static ubyte4                 j1939_pgn_base;
+static const J1939_HANDLER *  j1939_handlers;
+static ubyte1                 j1939_handler_count;
+static ubyte1                 j1939_source;
+
+/* one broadcast session at a time (BAM has no flow control, the sender just streams) */
+static bool   j1939_tp_active;
+static ubyte4 j1939_tp_pgn;
+static ubyte2 j1939_tp_size;
+static ubyte1 j1939_tp_packets;
+static ubyte1 j1939_tp_next;        /* next expected TP.DT sequence number (1-based) */
+static ubyte1 j1939_tp_buf[J1939_TP_MAX_SIZE];
+
+static ubyte4 j1939_tp_aborted;
+
+/**************************************************************************************************
+ * Local functions
+ *************************************************************************************************/
+
+/* PGN from a 29-bit identifier: PDU2 (PF >= 240) keeps the PS byte, PDU1 does not */
+static ubyte4 J1939_Pgn(ubyte4 id)
+{
+    ubyte4 pgn = (id >> 8) & 0x3FFFFu;
+
+    if (((pgn >> 8) & 0xFFu) < 240u)
+    {
+        pgn &= 0x3FF00u;
+    }
+    return pgn;
+}
+
+/* O(1) table lookup, NULL for unmapped PGNs */
+static J1939_HANDLER J1939_Lookup(ubyte4 pgn)
+{
+    ubyte4 slot = pgn - j1939_pgn_base;
+
+    if (slot >= j1939_handler_count)
+    {
+        return NULL;
+    }
+    return j1939_handlers[slot];
+}
+
+static void J1939_TpAbort(void)
+{
+    if (j1939_tp_active != FALSE)
+    {
+        j1939_tp_active = FALSE;
+        j1939_tp_aborted++;
+    }
+}
+
+/* TP.CM announce: opens a session if it is a BAM we can hold */
+static void J1939_TpControl(const ubyte1 * data)
+{
+    ubyte2 size;
+    ubyte1 packets;
+
+    if (data[0] != J1939_TP_CM_BAM)
+    {
+        return;     /* peer-to-peer transport is not used by the inverter */
+    }
+    J1939_TpAbort();    /* a new announce supersedes a running session */
+
+    size    = (ubyte2)((ubyte2)data[1] | ((ubyte2)data[2] << 8));
+    packets = data[3];
+    if ((size > J1939_TP_MAX_SIZE)
+     || (packets == 0u)
+     || ((ubyte2)packets * J1939_TP_PACKET_SIZE) < size)
+    {
+        j1939_tp_aborted++;
+        return;
+    }
+    j1939_tp_pgn     = (ubyte4)data[5]
+                     | ((ubyte4)data[6] << 8)
+                     | ((ubyte4)data[7] << 16);
+    j1939_tp_size    = size;
+    j1939_tp_packets = packets;
+    j1939_tp_next    = 1;
+    j1939_tp_active  = TRUE;
+}
+
+/* TP.DT packet: strictly in order, the last packet completes and dispatches */
+static void J1939_TpData(const ubyte1 * data)
+{
+    ubyte2 offset;
+    ubyte2 remaining;
+    ubyte1 i;
+
+    if ((j1939_tp_active == FALSE) || (data[0] != j1939_tp_next))
+    {
+        J1939_TpAbort();
+        return;
+    }
+    offset    = (ubyte2)((ubyte2)(data[0] - 1u) * J1939_TP_PACKET_SIZE);
+    remaining = (ubyte2)(j1939_tp_size - offset);
+    for (i = 0; (i < J1939_TP_PACKET_SIZE) && (i < remaining); i++)
+    {
+        j1939_tp_buf[offset + i] = data[1 + i];
+    }
+
+    if (j1939_tp_next >= j1939_tp_packets)
+    {
+        J1939_HANDLER handler = J1939_Lookup(j1939_tp_pgn);
+
+        j1939_tp_active = FALSE;
+        if (handler != NULL)
+        {
+            handler(j1939_tp_pgn, j1939_tp_buf, j1939_tp_size);
+        }
+    }
+    else
+    {
+        j1939_tp_next++;
+    }
+}
+
+/**************************************************************************************************
+ * Functions
+ *************************************************************************************************/
+
+void J1939_Init(ubyte4 pgn_base,
+                const J1939_HANDLER * handlers,
+                ubyte1 handler_count,
+                ubyte1 source)
+{
+    j1939_pgn_base      = pgn_base;
+    j1939_handlers      = handlers;
+    j1939_handler_count = handler_count;
+    j1939_source        = source;
+    j1939_tp_active     = FALSE;
+    j1939_tp_aborted    = 0;
+}
+
+ubyte1 J1939_Process(IO_CAN_DATA_FRAME * const frames, ubyte1 frame_count)
+{
+    ubyte1 kept = 0;
+    ubyte1 i;
+
+    for (i = 0; i < frame_count; i++)
+    {
+        IO_CAN_DATA_FRAME * frame = &frames[i];
+        bool consumed = FALSE;
+
+        if ((frame->id_format == IO_CAN_EXT_FRAME)
+         && ((ubyte1)(frame->id & 0xFFu) == j1939_source))
+        {
+            ubyte4 pgn = J1939_Pgn(frame->id);
+
+            if (pgn == J1939_PGN_TP_CM)
+            {
+                J1939_TpControl(frame->data);
+                consumed = TRUE;
+            }
+            else if (pgn == J1939_PGN_TP_DT)
+            {
+                J1939_TpData(frame->data);
+                consumed = TRUE;
+            }
+            else
+            {
+                J1939_HANDLER handler = J1939_Lookup(pgn);
+
+                if (handler != NULL)
+                {
+                    handler(pgn, frame->data, frame->length);
+                    consumed = TRUE;
+                }
+            }
+        }
+
+        if (consumed == FALSE)
+        {
+            /* compact in place so the gateway sees a dense batch */
+            if (kept != i)
+            {
+                frames[kept] = *frame;
+            }
+            kept++;
+        }
+    }
+    return kept;
+}
+
+ubyte4 J1939_AbortedSessions(void)
+{
+    return j1939_tp_aborted;
+}
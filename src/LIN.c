@@ -0,0 +1,59 @@
+/**************************************************************************************************
+ * Name
+ *    LIN.c
+ *
+ * Purpose
+ *    Fixed-point sensor linearization over the packed ADC array, see LIN.h.
+ *************************************************************************************************/
+
+#include "LIN.h"
+
+/**************************************************************************************************
+ * Global data
+ *************************************************************************************************/
+
+sbyte2 LIN_values[ADC_SCAN_NUM_CHANNELS];
+
+/**************************************************************************************************
+ * Functions
+ *************************************************************************************************/
+
+sbyte2 LIN_Convert(const LIN_TABLE * const table, ubyte4 raw)
+{
+    ubyte4 offset;
+    ubyte4 index;
+    ubyte4 fraction;
+    sbyte4 y0;
+    sbyte4 y1;
+
+    /* saturate below the first breakpoint */
+    if (raw <= table->x0)
+    {
+        return table->y[0];
+    }
+    offset = raw - table->x0;
+
+    /* equally spaced breakpoints: segment by shift, fraction by mask */
+    index    = offset >> table->shift;
+    fraction = offset & ((1u << table->shift) - 1u);
+
+    /* saturate above the last breakpoint */
+    if (index >= (ubyte4)(table->count - 1))
+    {
+        return table->y[table->count - 1];
+    }
+
+    y0 = table->y[index];
+    y1 = table->y[index + 1];
+    return (sbyte2)(y0 + (((y1 - y0) * (sbyte4)fraction) >> table->shift));
+}
+
+void LIN_ConvertAll(void)
+{
+    ubyte1 i;
+
+    for (i = 0; i < ADC_SCAN_NUM_CHANNELS; i++)
+    {
+        LIN_values[i] = LIN_Convert(&LIN_tables[i], ADC_SCAN_values[i]);
+    }
+}
@@ -0,0 +1,92 @@
+/**************************************************************************************************
+ * Name
+ *    LIN_TAB.c
+ *
+ * Purpose
+ *    Sensor linearization tables, generated by env/lingen.py from env/lincal.csv.
+ *
+ *    DO NOT EDIT: change env/lincal.csv and regenerate instead.
+ *************************************************************************************************/
+
+#include "LIN.h"
+
+/* AI_103 temp NN */
+static const sbyte2 lin_y_00[5] =
+{
+      -400,     13,    425,    838,   1250,
+};
+
+/* AI_127 temp VN */
+static const sbyte2 lin_y_01[5] =
+{
+      -400,     13,    425,    838,   1250,
+};
+
+/* AI_104 PTC_1 */
+static const sbyte2 lin_y_02[5] =
+{
+         0,   2500,   5000,   7500,  10000,
+};
+
+/* AI_128 PTC_2 */
+static const sbyte2 lin_y_03[5] =
+{
+         0,   2500,   5000,   7500,  10000,
+};
+
+/* AI_105 stator 1 */
+static const sbyte2 lin_y_04[11] =
+{
+      -400,   -100,    200,    500,    800,   1100,   1400,   1700,
+      2000,   2300,   2600,
+};
+
+/* AI_129 stator 2 */
+static const sbyte2 lin_y_05[11] =
+{
+      -400,   -100,    200,    500,    800,   1100,   1400,   1700,
+      2000,   2300,   2600,
+};
+
+/* AI_106 stator 3 */
+static const sbyte2 lin_y_06[11] =
+{
+      -400,   -100,    200,    500,    800,   1100,   1400,   1700,
+      2000,   2300,   2600,
+};
+
+/* AI_130 stator 4 */
+static const sbyte2 lin_y_07[11] =
+{
+      -400,   -100,    200,    500,    800,   1100,   1400,   1700,
+      2000,   2300,   2600,
+};
+
+/* AI_107 stator 5 */
+static const sbyte2 lin_y_08[11] =
+{
+      -400,   -100,    200,    500,    800,   1100,   1400,   1700,
+      2000,   2300,   2600,
+};
+
+/* AI_131 stator 6 */
+static const sbyte2 lin_y_09[11] =
+{
+      -400,   -100,    200,    500,    800,   1100,   1400,   1700,
+      2000,   2300,   2600,
+};
+
+const LIN_TABLE LIN_tables[10] =
+{
+    /*  x0     shift  count  breakpoints */
+    {  4000,  12,   5,  lin_y_00 },  /* AI_103 temp NN */
+    {  4000,  12,   5,  lin_y_01 },  /* AI_127 temp VN */
+    {  4000,  12,   5,  lin_y_02 },  /* AI_104 PTC_1 */
+    {  4000,  12,   5,  lin_y_03 },  /* AI_128 PTC_2 */
+    {     0,  10,  11,  lin_y_04 },  /* AI_105 stator 1 */
+    {     0,  10,  11,  lin_y_05 },  /* AI_129 stator 2 */
+    {     0,  10,  11,  lin_y_06 },  /* AI_106 stator 3 */
+    {     0,  10,  11,  lin_y_07 },  /* AI_130 stator 4 */
+    {     0,  10,  11,  lin_y_08 },  /* AI_107 stator 5 */
+    {     0,  10,  11,  lin_y_09 },  /* AI_131 stator 6 */
+};
@@ -0,0 +1,58 @@
+/**************************************************************************************************
+ * Name
+ *    MPU_GUARD.c
+ *
+ * Purpose
+ *    Hardware guard strips around the application buffer pool, see MPU_GUARD.h.
+ *************************************************************************************************/
+
+#include "MPU_GUARD.h"
+
+/**************************************************************************************************
+ * Functions
+ *************************************************************************************************/
+
+IO_ErrorType MPU_GUARD_Init(void)
+{
+    IO_ErrorType io_error = IO_E_OK;
+    IO_ErrorType step_error;
+
+    /* the driver drops every user region for its internal tasks, so the guard
+     * strips never obstruct the I/O driver itself */
+    step_error = IO_MPU_Policy(IO_MPU_POLICY_ALLREGIONS);
+    if (step_error != IO_E_OK)
+    {
+        io_error = step_error;      /* report the last failing step */
+    }
+
+    step_error = IO_MPU_Init(IO_MPU_REGION_2,
+                             MPU_GUARD_STRIP_LO,
+                             IO_MPU_SIZE_32_B,
+                             IO_MPU_ENABLE_ALL_SUBREGIONS,
+                             IO_MPU_ACCESS_NONE);
+    if (step_error != IO_E_OK)
+    {
+        io_error = step_error;
+    }
+    step_error = IO_MPU_Init(IO_MPU_REGION_3,
+                             MPU_GUARD_STRIP_HI,
+                             IO_MPU_SIZE_32_B,
+                             IO_MPU_ENABLE_ALL_SUBREGIONS,
+                             IO_MPU_ACCESS_NONE);
+    if (step_error != IO_E_OK)
+    {
+        io_error = step_error;
+    }
+
+    step_error = IO_MPU_Enable(IO_MPU_REGION_2);
+    if (step_error != IO_E_OK)
+    {
+        io_error = step_error;
+    }
+    step_error = IO_MPU_Enable(IO_MPU_REGION_3);
+    if (step_error != IO_E_OK)
+    {
+        io_error = step_error;
+    }
+    return io_error;
+}
@@ -0,0 +1,259 @@
+/**************************************************************************************************
+ * Name
+ *    ODO.c
+ *
+ * Purpose
+ *    Persistent odometer-style counters over a round-robin EEPROM journal, see ODO.h.
+ *************************************************************************************************/
+
+#include <stddef.h>     /* offsetof */
+
+#include "ODO.h"
+
+/**************************************************************************************************
+ * Static data
+ *************************************************************************************************/
+
+typedef struct odo_slot_
+{
+    ubyte4 sequence;                    /* monotonic commit number, 0 = never written */
+    ubyte4 values[ODO_NUM_COUNTERS];    /* counter payload                            */
+    ubyte2 crc;                         /* CRC-16/CCITT over sequence and values      */
+} ODO_SLOT;
+
+/* live counters; volatile because ODO_Increment also runs in callback context */
+static volatile ubyte4 odo_values[ODO_NUM_COUNTERS];
+
+/* last committed payload, compared against odo_values to detect dirt (keeps the
+ * increment itself to a single add, no flag store) */
+static ubyte4 odo_committed[ODO_NUM_COUNTERS];
+
+/* copy handed to the asynchronous EEPROM write (the driver requires the
+ * buffer to stay valid for the whole write duration) */
+static ODO_SLOT odo_write_slot;
+
+/* whole journal, read once at boot in a single driver transfer */
+static ODO_SLOT odo_journal[ODO_NUM_SLOTS];
+
+/* journal state machine */
+#define ODO_ST_OFF          0   /* before ODO_Init                          */
+#define ODO_ST_SCAN_START   1   /* boot read not issued yet (driver busy)   */
+#define ODO_ST_SCAN_WAIT    2   /* boot read in flight                      */
+#define ODO_ST_READY        3   /* journal merged, commits allowed          */
+#define ODO_ST_WRITING      4   /* journal write in flight                  */
+static ubyte1 odo_state;
+
+static ubyte4 odo_sequence;     /* sequence of the newest valid slot        */
+static ubyte1 odo_task_calls;   /* 100 ms prescaler for the seconds counter */
+static ubyte2 odo_commit_timer; /* seconds since the last commit            */
+static ubyte4 odo_commit_count;
+
+/**************************************************************************************************
+ * Local functions
+ *************************************************************************************************/
+
+/* CRC-16/CCITT, bitwise -- runs only at boot and once per commit */
+static ubyte2 ODO_Crc(const ubyte1 * data, ubyte2 length)
+{
+    ubyte2 crc = 0xFFFF;
+    ubyte2 i;
+    ubyte1 bit;
+
+    for (i = 0; i < length; i++)
+    {
+        crc ^= (ubyte2)((ubyte2)data[i] << 8);
+        for (bit = 0; bit < 8; bit++)
+        {
+            if ((crc & 0x8000) != 0)
+            {
+                crc = (ubyte2)((crc << 1) ^ 0x1021);
+            }
+            else
+            {
+                crc = (ubyte2)(crc << 1);
+            }
+        }
+    }
+    return crc;
+}
+
+/* up to the crc field, not sizeof minus crc: the struct pads to a multiple of 4,
+ * and the padded length would fold the stored crc into its own input */
+#define ODO_CRC_LENGTH      ((ubyte2)offsetof(ODO_SLOT, crc))
+
+/* issues the one bounded boot read of the whole journal */
+static void ODO_ScanStart(void)
+{
+    if (IO_EEPROM_GetStatus() != IO_E_OK)
+    {
+        return;     /* driver busy (e.g. PARAM write-back), retry next call */
+    }
+    if (IO_EEPROM_Read(ODO_EEPROM_OFFSET,
+                       sizeof(odo_journal),
+                       (ubyte1 *)odo_journal) == IO_E_OK)
+    {
+        odo_state = ODO_ST_SCAN_WAIT;
+    }
+}
+
+/* picks the newest valid slot and merges it under the increments made since boot */
+static void ODO_ScanFinish(void)
+{
+    const ODO_SLOT * best = (const ODO_SLOT *)0;
+    ubyte1 slot;
+    ubyte1 i;
+
+    for (slot = 0; slot < ODO_NUM_SLOTS; slot++)
+    {
+        const ODO_SLOT * cand = &odo_journal[slot];
+
+        if ((cand->crc == ODO_Crc((const ubyte1 *)cand, ODO_CRC_LENGTH))
+         && ((best == (const ODO_SLOT *)0) || (cand->sequence > best->sequence)))
+        {
+            best = cand;
+        }
+    }
+
+    if (best != (const ODO_SLOT *)0)
+    {
+        odo_sequence = best->sequence;
+        for (i = 0; i < ODO_NUM_COUNTERS; i++)
+        {
+            /* journal base plus whatever was counted while the scan ran */
+            odo_values[i]   += best->values[i];
+            odo_committed[i] = best->values[i];
+        }
+    }
+    /* no valid slot: blank or corrupt journal, counting starts from zero */
+    odo_state = ODO_ST_READY;
+}
+
+/* one journal write: next sequence, next slot round robin */
+static void ODO_Commit(void)
+{
+    ubyte1 i;
+    bool dirty = FALSE;
+
+    for (i = 0; i < ODO_NUM_COUNTERS; i++)
+    {
+        odo_write_slot.values[i] = odo_values[i];
+        if (odo_write_slot.values[i] != odo_committed[i])
+        {
+            dirty = TRUE;
+        }
+    }
+    if (dirty == FALSE)
+    {
+        return;     /* nothing counted since the last commit, spare the EEPROM */
+    }
+    if (IO_EEPROM_GetStatus() != IO_E_OK)
+    {
+        return;     /* driver busy, retried next second */
+    }
+
+    odo_write_slot.sequence = odo_sequence + 1u;
+    odo_write_slot.crc      = ODO_Crc((const ubyte1 *)&odo_write_slot, ODO_CRC_LENGTH);
+
+    if (IO_EEPROM_Write((ubyte2)(ODO_EEPROM_OFFSET
+                        + ((odo_write_slot.sequence % ODO_NUM_SLOTS) * sizeof(ODO_SLOT))),
+                        sizeof(ODO_SLOT),
+                        (const ubyte1 *)&odo_write_slot) == IO_E_OK)
+    {
+        odo_sequence = odo_write_slot.sequence;
+        for (i = 0; i < ODO_NUM_COUNTERS; i++)
+        {
+            odo_committed[i] = odo_write_slot.values[i];
+        }
+        odo_commit_count++;
+        odo_commit_timer = 0;
+        odo_state = ODO_ST_WRITING;
+    }
+}
+
+/**************************************************************************************************
+ * Functions
+ *************************************************************************************************/
+
+IO_ErrorType ODO_Init(void)
+{
+    ubyte1 i;
+
+    for (i = 0; i < ODO_NUM_COUNTERS; i++)
+    {
+        odo_values[i]    = 0;
+        odo_committed[i] = 0;
+    }
+    odo_sequence     = 0;
+    odo_task_calls   = 0;
+    odo_commit_timer = 0;
+    odo_commit_count = 0;
+
+    /* the read is issued from ODO_Task: the driver may still be busy with the
+     * PARAM write-back, and waiting is not acceptable inside a 1 ms tick */
+    odo_state = ODO_ST_SCAN_START;
+    ODO_ScanStart();
+    return IO_E_OK;
+}
+
+void ODO_Increment(ubyte1 id)
+{
+    odo_values[id]++;
+}
+
+ubyte4 ODO_Get(ubyte1 id)
+{
+    return odo_values[id];
+}
+
+void ODO_Task(void)
+{
+    /* operating time, independent of the journal state */
+    if (odo_state != ODO_ST_OFF)
+    {
+        odo_task_calls++;
+        if (odo_task_calls >= 10u)      /* called once per 100 ms */
+        {
+            odo_task_calls = 0;
+            ODO_Increment(ODO_ID_SECONDS);
+            odo_commit_timer++;
+        }
+    }
+
+    switch (odo_state)
+    {
+        case ODO_ST_SCAN_START:
+            ODO_ScanStart();
+            break;
+
+        case ODO_ST_SCAN_WAIT:
+            if (IO_EEPROM_GetStatus() != IO_E_BUSY)
+            {
+                ODO_ScanFinish();
+            }
+            break;
+
+        case ODO_ST_READY:
+            if (odo_commit_timer >= ODO_COMMIT_PERIOD_S)
+            {
+                ODO_Commit();
+            }
+            break;
+
+        case ODO_ST_WRITING:
+            if (IO_EEPROM_GetStatus() != IO_E_BUSY)
+            {
+                /* done, or failed: a failure costs nothing, the counters are
+                 * still in RAM and the next period writes the following slot */
+                odo_state = ODO_ST_READY;
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+ubyte4 ODO_Commits(void)
+{
+    return odo_commit_count;
+}
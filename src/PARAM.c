@@ -0,0 +1,180 @@
+/**************************************************************************************************
+ * Name
+ *    PARAM.c
+ *
+ * Purpose
+ *    EEPROM-backed parameter store with a RAM shadow and asynchronous write-back, see PARAM.h.
+ *************************************************************************************************/
+
+#include "PARAM.h"
+#include "MPU_GUARD.h"
+
+/**************************************************************************************************
+ * Static data
+ *************************************************************************************************/
+
+typedef struct param_block_
+{
+    ubyte2 version;                     /* PARAM_BLOCK_VERSION                   */
+    ubyte2 values[PARAM_NUM_PARAMS];    /* parameter payload                     */
+    ubyte2 crc;                         /* CRC-16/CCITT over version and values  */
+} PARAM_BLOCK;
+
+/* RAM shadow served to the application */
+MPU_GUARD_DATA(param_shadow)
+static PARAM_BLOCK param_shadow;
+
+/* copy handed to the asynchronous EEPROM write (the driver requires the
+ * buffer to stay valid for the whole write duration) */
+MPU_GUARD_DATA(param_write_buf)
+static PARAM_BLOCK param_write_buf;
+
+/* write-back state machine */
+#define PARAM_WB_IDLE       0   /* nothing to do                    */
+#define PARAM_WB_DIRTY      1   /* shadow changed, write not started */
+#define PARAM_WB_WRITING    2   /* EEPROM write in flight            */
+static ubyte1 param_wb_state;
+
+/* factory defaults, used when the EEPROM block is missing or corrupt */
+static const ubyte2 param_defaults[PARAM_NUM_PARAMS] =
+{
+    1,      /* PARAM_ID_KP */
+    0,      /* PARAM_ID_KI */
+    0       /* PARAM_ID_KD */
+};
+
+/**************************************************************************************************
+ * Functions
+ *************************************************************************************************/
+
+/* CRC-16/CCITT, bitwise -- runs only at init and before a write-back */
+static ubyte2 PARAM_Crc(const ubyte1 * data, ubyte2 length)
+{
+    ubyte2 crc = 0xFFFF;
+    ubyte2 i;
+    ubyte1 bit;
+
+    for (i = 0; i < length; i++)
+    {
+        crc ^= (ubyte2)((ubyte2)data[i] << 8);
+        for (bit = 0; bit < 8; bit++)
+        {
+            if ((crc & 0x8000) != 0)
+            {
+                crc = (ubyte2)((crc << 1) ^ 0x1021);
+            }
+            else
+            {
+                crc = (ubyte2)(crc << 1);
+            }
+        }
+    }
+    return crc;
+}
+
+#define PARAM_CRC_LENGTH    ((ubyte2)(sizeof(PARAM_BLOCK) - sizeof(ubyte2)))
+
+static void PARAM_LoadDefaults(void)
+{
+    ubyte1 i;
+
+    param_shadow.version = PARAM_BLOCK_VERSION;
+    for (i = 0; i < PARAM_NUM_PARAMS; i++)
+    {
+        param_shadow.values[i] = param_defaults[i];
+    }
+    param_shadow.crc = PARAM_Crc((const ubyte1 *)&param_shadow, PARAM_CRC_LENGTH);
+}
+
+IO_ErrorType PARAM_Init(void)
+{
+    IO_ErrorType io_error;
+
+    io_error = IO_EEPROM_Init();
+    if (io_error != IO_E_OK)
+    {
+        PARAM_LoadDefaults();
+        param_wb_state = PARAM_WB_IDLE;
+        return io_error;
+    }
+
+    /* startup is the one place where waiting for the EEPROM is acceptable */
+    while (IO_EEPROM_GetStatus() == IO_E_BUSY)
+    {
+    }
+    io_error = IO_EEPROM_Read(PARAM_EEPROM_OFFSET,
+                              sizeof(PARAM_BLOCK),
+                              (ubyte1 *)&param_shadow);
+    if (io_error == IO_E_OK)
+    {
+        while (IO_EEPROM_GetStatus() == IO_E_BUSY)
+        {
+        }
+    }
+
+    if ((io_error != IO_E_OK)
+     || (param_shadow.version != PARAM_BLOCK_VERSION)
+     || (param_shadow.crc != PARAM_Crc((const ubyte1 *)&param_shadow, PARAM_CRC_LENGTH)))
+    {
+        /* invalid or incompatible block: run on defaults and persist them lazily */
+        PARAM_LoadDefaults();
+        param_wb_state = PARAM_WB_DIRTY;
+    }
+    else
+    {
+        param_wb_state = PARAM_WB_IDLE;
+    }
+    return IO_E_OK;
+}
+
+ubyte2 PARAM_Get(ubyte1 id)
+{
+    return param_shadow.values[id];
+}
+
+void PARAM_Set(ubyte1 id, ubyte2 value)
+{
+    if (param_shadow.values[id] != value)
+    {
+        param_shadow.values[id] = value;
+        param_wb_state = PARAM_WB_DIRTY;
+    }
+}
+
+void PARAM_Task(void)
+{
+    switch (param_wb_state)
+    {
+        case PARAM_WB_DIRTY:
+            if (IO_EEPROM_GetStatus() == IO_E_OK)
+            {
+                param_shadow.crc = PARAM_Crc((const ubyte1 *)&param_shadow,
+                                             PARAM_CRC_LENGTH);
+                param_write_buf  = param_shadow;
+                if (IO_EEPROM_Write(PARAM_EEPROM_OFFSET,
+                                    sizeof(PARAM_BLOCK),
+                                    (const ubyte1 *)&param_write_buf) == IO_E_OK)
+                {
+                    param_wb_state = PARAM_WB_WRITING;
+                }
+            }
+            break;
+
+        case PARAM_WB_WRITING:
+            if (IO_EEPROM_GetStatus() != IO_E_BUSY)
+            {
+                /* done, or failed: a failure leaves the shadow valid and retries
+                 * on the next PARAM_Set */
+                param_wb_state = PARAM_WB_IDLE;
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+bool PARAM_IsClean(void)
+{
+    return (param_wb_state == PARAM_WB_IDLE) ? TRUE : FALSE;
+}
@@ -0,0 +1,108 @@
+/**************************************************************************************************
+ * Name
+ *    PID.c
+ *
+ * Purpose
+ *    Fixed-point PID controller with persistent state and saturating arithmetic, see PID.h.
+ *************************************************************************************************/
+
+#include "PID.h"
+
+#define PID_SBYTE4_MAX  ((sbyte4)0x7FFFFFFF)
+#define PID_SBYTE4_MIN  ((sbyte4)0x80000000)
+
+/* saturating 32-bit add */
+static sbyte4 PID_SatAdd(sbyte4 a, sbyte4 b)
+{
+    if ((b > 0) && (a > (PID_SBYTE4_MAX - b)))
+    {
+        return PID_SBYTE4_MAX;
+    }
+    if ((b < 0) && (a < (PID_SBYTE4_MIN - b)))
+    {
+        return PID_SBYTE4_MIN;
+    }
+    return a + b;
+}
+
+/* saturating Q16 * Q16 multiply, result Q16 (one SMULL plus a shift on the R4) */
+static sbyte4 PID_MulQ16(sbyte4 gain_q16, sbyte4 value_q16)
+{
+    sbyte8 product = ((sbyte8)gain_q16 * (sbyte8)value_q16) >> 16;
+
+    if (product > (sbyte8)PID_SBYTE4_MAX)
+    {
+        return PID_SBYTE4_MAX;
+    }
+    if (product < (sbyte8)PID_SBYTE4_MIN)
+    {
+        return PID_SBYTE4_MIN;
+    }
+    return (sbyte4)product;
+}
+
+static sbyte4 PID_Clamp(sbyte4 value, sbyte4 min, sbyte4 max)
+{
+    if (value > max)
+    {
+        return max;
+    }
+    if (value < min)
+    {
+        return min;
+    }
+    return value;
+}
+
+void PID_Init(PID_STATE * const state,
+              sbyte4 kp_q16,
+              sbyte4 ki_q16,
+              sbyte4 kd_q16,
+              ubyte4 period_us,
+              sbyte4 out_min,
+              sbyte4 out_max)
+{
+    if (period_us == 0)
+    {
+        period_us = 1;  /* guard against division by zero */
+    }
+
+    state->kp_q16        = kp_q16;
+    /* premultiply with the cycle time so the hot path has no division:
+     * ki*dt = ki * period_us / 1e6, kd/dt = kd * 1e6 / period_us */
+    state->ki_dt_q16     = (sbyte4)(((sbyte8)ki_q16 * (sbyte8)period_us) / 1000000);
+    state->kd_inv_dt_q16 = (sbyte4)(((sbyte8)kd_q16 * 1000000) / (sbyte8)period_us);
+    state->out_min       = out_min;
+    state->out_max       = out_max;
+    PID_Reset(state);
+}
+
+void PID_Reset(PID_STATE * const state)
+{
+    state->integral_q16   = 0;
+    state->previous_error = 0;
+}
+
+sbyte4 PID_Update(PID_STATE * const state,
+                  sbyte4 setpoint,
+                  sbyte4 measured)
+{
+    sbyte4 error = setpoint - measured;
+    sbyte4 p_q16;
+    sbyte4 d_q16;
+    sbyte4 out_q16;
+
+    p_q16 = PID_MulQ16(state->kp_q16, error);
+
+    /* integrate with anti-windup: the integral alone may never exceed the output limits */
+    state->integral_q16 = PID_Clamp(PID_SatAdd(state->integral_q16,
+                                               PID_MulQ16(state->ki_dt_q16, error)),
+                                    state->out_min,
+                                    state->out_max);
+
+    d_q16 = PID_MulQ16(state->kd_inv_dt_q16, error - state->previous_error);
+    state->previous_error = error;
+
+    out_q16 = PID_SatAdd(PID_SatAdd(p_q16, state->integral_q16), d_q16);
+    return PID_Clamp(out_q16, state->out_min, state->out_max);
+}
@@ -0,0 +1,122 @@
+/**************************************************************************************************
+ * Name
+ *    PROF.c
+ *
+ * Purpose
+ *    Lightweight cycle-budget profiler, see PROF.h.
+ *************************************************************************************************/
+
+#include "PROF.h"
+#include "CAN_TX.h"
+
+/**************************************************************************************************
+ * Static data
+ *************************************************************************************************/
+
+static ubyte4     prof_start[PROF_NUM_SECTIONS];
+static PROF_STATS prof_stats[PROF_NUM_SECTIONS];
+
+/**************************************************************************************************
+ * Functions
+ *************************************************************************************************/
+
+static void PROF_ResetWindow(PROF_STATS * const stats)
+{
+    stats->min_us = 0xFFFF;
+    stats->max_us = 0;
+    stats->sum_us = 0;
+    stats->count  = 0;
+}
+
+void PROF_Init(void)
+{
+    ubyte1 i;
+    ubyte1 bin;
+
+    for (i = 0; i < PROF_NUM_SECTIONS; i++)
+    {
+        PROF_ResetWindow(&prof_stats[i]);
+        for (bin = 0; bin < PROF_HIST_BINS; bin++)
+        {
+            prof_stats[i].hist[bin] = 0;
+        }
+    }
+}
+
+void PROF_Begin(ubyte1 section)
+{
+    (void)IO_RTC_StartTime(&prof_start[section]);
+}
+
+void PROF_End(ubyte1 section)
+{
+    PROF_Sample(section, IO_RTC_GetTimeUS(prof_start[section]));
+}
+
+void PROF_Sample(ubyte1 section, ubyte4 elapsed)
+{
+    PROF_STATS * stats = &prof_stats[section];
+    ubyte4 v;
+    ubyte1 bin;
+
+    if (elapsed < stats->min_us)
+    {
+        stats->min_us = (ubyte2)elapsed;
+    }
+    if (elapsed > stats->max_us)
+    {
+        stats->max_us = (elapsed > 0xFFFF) ? (ubyte2)0xFFFF : (ubyte2)elapsed;
+    }
+    stats->sum_us += elapsed;
+    stats->count++;
+
+    /* log2 bucket: index of the highest set bit */
+    bin = 0;
+    v   = elapsed;
+    while ((v >>= 1) != 0)
+    {
+        bin++;
+    }
+    if (bin >= PROF_HIST_BINS)
+    {
+        bin = PROF_HIST_BINS - 1;
+    }
+    if (stats->hist[bin] < 0xFFFF)
+    {
+        stats->hist[bin]++;
+    }
+}
+
+const PROF_STATS * PROF_GetStats(ubyte1 section)
+{
+    return &prof_stats[section];
+}
+
+void PROF_Report(ubyte2 can_handle)
+{
+    IO_CAN_DATA_FRAME frame;
+    ubyte1 i;
+
+    frame.id_format = IO_CAN_STD_FRAME;
+    frame.length    = 8;
+
+    for (i = 0; i < PROF_NUM_SECTIONS; i++)
+    {
+        PROF_STATS * stats = &prof_stats[i];
+        ubyte2 mean_us = (stats->count > 0) ? (ubyte2)(stats->sum_us / stats->count) : 0;
+        ubyte2 min_us  = (stats->count > 0) ? stats->min_us : 0;
+
+        frame.id      = PROF_REPORT_BASE_ID + i;
+        frame.data[0] = (ubyte1)(min_us >> 8);
+        frame.data[1] = (ubyte1)min_us;
+        frame.data[2] = (ubyte1)(stats->max_us >> 8);
+        frame.data[3] = (ubyte1)stats->max_us;
+        frame.data[4] = (ubyte1)(mean_us >> 8);
+        frame.data[5] = (ubyte1)mean_us;
+        frame.data[6] = (ubyte1)(stats->count >> 8);
+        frame.data[7] = (ubyte1)stats->count;
+        (void)CAN_TX_Enqueue(can_handle, &frame);
+
+        PROF_ResetWindow(stats);
+    }
+}
@@ -0,0 +1,106 @@
+/**************************************************************************************************
+ * Name
+ *    PWM_OUT.c
+ *
+ * Purpose
+ *    PWM output stage with queue-based current feedback, see PWM_OUT.h.
+ *************************************************************************************************/
+
+#include "PWM_OUT.h"
+#include "BOARD.h"
+
+/**************************************************************************************************
+ * Static data
+ *************************************************************************************************/
+
+/* pin assignments come from the board layer (BOARD_pwm_channels) */
+
+static ubyte2 pwm_out_duty[PWM_OUT_NUM_CHANNELS];
+static ubyte2 pwm_out_avg_ma[PWM_OUT_NUM_CHANNELS];
+static ubyte1 pwm_out_fault[PWM_OUT_NUM_CHANNELS];
+
+/**************************************************************************************************
+ * Functions
+ *************************************************************************************************/
+
+IO_ErrorType PWM_OUT_Init(void)
+{
+    IO_ErrorType io_error = IO_E_OK;
+    ubyte1 i;
+
+    for (i = 0; i < PWM_OUT_NUM_CHANNELS; i++)
+    {
+        IO_ErrorType channel_error;
+
+        channel_error = IO_PWM_Init(BOARD_pwm_channels[i],
+                                    PWM_OUT_FREQUENCY,  /* 200 Hz                  */
+                                    TRUE,               /* positive polarity       */
+                                    FALSE,              /* no diag margin          */
+                                    NULL);              /* not safety critical     */
+        if (channel_error != IO_E_OK)
+        {
+            io_error = channel_error;   /* report the last failing channel */
+        }
+        pwm_out_duty[i]   = 0;
+        pwm_out_avg_ma[i] = 0;
+        pwm_out_fault[i]  = PWM_OUT_LOAD_OK;
+    }
+    return io_error;
+}
+
+void PWM_OUT_SetDuty(ubyte1 channel, ubyte2 duty)
+{
+    pwm_out_duty[channel] = duty;
+}
+
+void PWM_OUT_Task(void)
+{
+    ubyte1 i;
+
+    for (i = 0; i < PWM_OUT_NUM_CHANNELS; i++)
+    {
+        IO_PWM_CURRENT_QUEUE current_queue;
+        ubyte1 sample;
+
+        (void)IO_PWM_SetDuty(BOARD_pwm_channels[i], pwm_out_duty[i], NULL, NULL);
+
+        /* one driver call fetches every sample buffered since the last cycle */
+        if (IO_PWM_GetCurQueue(BOARD_pwm_channels[i], &current_queue) != IO_E_OK)
+        {
+            continue;
+        }
+        for (sample = 0; sample < current_queue.count; sample++)
+        {
+            /* incremental moving average, integer only */
+            sbyte4 delta = (sbyte4)current_queue.values[sample]
+                         - (sbyte4)pwm_out_avg_ma[i];
+
+            pwm_out_avg_ma[i] = (ubyte2)((sbyte4)pwm_out_avg_ma[i]
+                                         + (delta >> PWM_OUT_AVG_SHIFT));
+        }
+
+        /* load supervision on the filtered current */
+        if (pwm_out_avg_ma[i] > PWM_OUT_OVERCURRENT_MA)
+        {
+            pwm_out_fault[i] = PWM_OUT_LOAD_OVERCUR;
+        }
+        else if ((pwm_out_duty[i] >= 0x8000) && (pwm_out_avg_ma[i] < PWM_OUT_OPEN_LOAD_MA))
+        {
+            pwm_out_fault[i] = PWM_OUT_LOAD_OPEN;   /* driven but no current flows */
+        }
+        else
+        {
+            pwm_out_fault[i] = PWM_OUT_LOAD_OK;
+        }
+    }
+}
+
+ubyte2 PWM_OUT_Current(ubyte1 channel)
+{
+    return pwm_out_avg_ma[channel];
+}
+
+ubyte1 PWM_OUT_Fault(ubyte1 channel)
+{
+    return pwm_out_fault[channel];
+}
@@ -0,0 +1,119 @@
+/**************************************************************************************************
+ * Name
+ *    SCHED.c
+ *
+ * Purpose
+ *    Static task table scheduler with millisecond rate groups, see SCHED.h.
+ *************************************************************************************************/
+
+#include "SCHED.h"
+
+/**************************************************************************************************
+ * Static data
+ *************************************************************************************************/
+
+typedef struct sched_task_
+{
+    SCHED_TASK_FN fn;
+    ubyte2        period_ms;
+    ubyte2        phase_ms;
+} SCHED_TASK;
+
+static SCHED_TASK sched_tasks[SCHED_MAX_TASKS];
+static ubyte1 sched_task_count;
+
+/* written by the periodic interrupt, read by the main loop */
+static volatile ubyte4 sched_ticks;
+
+/* tick the main loop has dispatched up to */
+static ubyte4 sched_dispatched_tick;
+
+static ubyte4 sched_overrun_ticks;
+
+/**************************************************************************************************
+ * Functions
+ *************************************************************************************************/
+
+/* periodic interrupt: count only, no I/O driver calls allowed in this context */
+static void SCHED_TickCb(void)
+{
+    sched_ticks++;
+}
+
+IO_ErrorType SCHED_Init(void)
+{
+    ubyte1 i;
+
+    for (i = 0; i < SCHED_MAX_TASKS; i++)
+    {
+        sched_tasks[i].fn = NULL;
+    }
+    sched_task_count      = 0;
+    sched_ticks           = 0;
+    sched_dispatched_tick = 0;
+    sched_overrun_ticks   = 0;
+
+    return IO_RTC_PeriodicInit((ubyte2)SCHED_TICK_US, &SCHED_TickCb);
+}
+
+IO_ErrorType SCHED_AddTask(SCHED_TASK_FN task, ubyte2 period_ms, ubyte2 phase_ms)
+{
+    if ((task == NULL) || (period_ms == 0))
+    {
+        return IO_E_INVALID_PARAMETER;
+    }
+    if (sched_task_count >= SCHED_MAX_TASKS)
+    {
+        return IO_E_INVALID_PARAMETER;
+    }
+    sched_tasks[sched_task_count].fn        = task;
+    sched_tasks[sched_task_count].period_ms = period_ms;
+    sched_tasks[sched_task_count].phase_ms  = (ubyte2)(phase_ms % period_ms);
+    sched_task_count++;
+    return IO_E_OK;
+}
+
+void SCHED_Dispatch(void)
+{
+    ubyte4 now = sched_ticks;
+
+    /* if the task set overran, skip to the current tick instead of replaying
+     * every missed slot (the safety window has been violated anyway) */
+    if ((now - sched_dispatched_tick) > 1)
+    {
+        sched_overrun_ticks += (now - sched_dispatched_tick) - 1;
+        sched_dispatched_tick = now - 1;
+    }
+
+    if (now != sched_dispatched_tick)
+    {
+        ubyte1 i;
+
+        sched_dispatched_tick = now;
+        for (i = 0; i < sched_task_count; i++)
+        {
+            if ((now % sched_tasks[i].period_ms) == sched_tasks[i].phase_ms)
+            {
+                sched_tasks[i].fn();
+            }
+        }
+    }
+}
+
+void SCHED_WaitTick(void)
+{
+    while (sched_ticks == sched_dispatched_tick)
+    {
+        /* idle until the periodic interrupt advances the counter */
+    }
+}
+
+ubyte4 SCHED_GetTick(void)
+{
+    return sched_ticks;
+}
+
+ubyte4 SCHED_OverrunTicks(void)
+{
+    return sched_overrun_ticks;
+}
@@ -0,0 +1,62 @@
+/**************************************************************************************************
+ * Name
+ *    SNAP.c
+ *
+ * Purpose
+ *    Double-buffered per-cycle input snapshot, see SNAP.h.
+ *************************************************************************************************/
+
+#include "SNAP.h"
+#include "MPU_GUARD.h"
+
+/**************************************************************************************************
+ * Static data
+ *************************************************************************************************/
+
+MPU_GUARD_DATA(snap_buffers)
+static SNAP_INPUTS snap_buffers[2];
+static volatile ubyte1 snap_front;      /* index of the published buffer */
+
+/**************************************************************************************************
+ * Functions
+ *************************************************************************************************/
+
+void SNAP_Init(void)
+{
+    ubyte1 i;
+    ubyte1 channel;
+
+    snap_front = 0;
+    for (i = 0; i < 2; i++)
+    {
+        snap_buffers[i].tick = 0;
+        snap_buffers[i].di   = 0;
+        for (channel = 0; channel < WHEEL_NUM_CHANNELS; channel++)
+        {
+            snap_buffers[i].wheel_q16[channel] = 0;
+        }
+        snap_buffers[i].vehicle_speed_q16 = 0;
+        for (channel = 0; channel < ADC_SCAN_NUM_CHANNELS; channel++)
+        {
+            snap_buffers[i].ai_raw[channel] = 0;
+            snap_buffers[i].ai_eng[channel] = 0;
+        }
+        snap_buffers[i].ai_fresh = 0;
+    }
+}
+
+SNAP_INPUTS * SNAP_Back(void)
+{
+    return &snap_buffers[1u - snap_front];
+}
+
+void SNAP_Publish(void)
+{
+    /* single aligned byte store: readers see the old or the new buffer, never a mix */
+    snap_front = (ubyte1)(1u - snap_front);
+}
+
+const SNAP_INPUTS * SNAP_Front(void)
+{
+    return &snap_buffers[snap_front];
+}
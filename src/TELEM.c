@@ -0,0 +1,122 @@
+/**************************************************************************************************
+ * Name
+ *    TELEM.c
+ *
+ * Purpose
+ *    Binary telemetry snapshots over UDP multicast, see TELEM.h.
+ *************************************************************************************************/
+
+#include "TELEM.h"
+#include "ADC_SCAN.h"
+#include "DI_SCAN.h"
+#include "PROF.h"
+
+/**************************************************************************************************
+ * Static data
+ *************************************************************************************************/
+
+/* wire layout of one snapshot; the struct is the packet buffer */
+typedef struct telem_packet_
+{
+    /* header, written once at init */
+    ubyte2 magic;
+    ubyte1 version;
+    ubyte1 reserved;
+
+    /* payload, poked in place each send */
+    ubyte4 sequence;
+    ubyte4 tick;
+    ubyte2 ai[ADC_SCAN_NUM_CHANNELS];
+    ubyte2 ai_fresh;
+    ubyte4 di;
+    ubyte2 torque;
+    sbyte4 pid_integral_q16;
+    sbyte4 pid_previous_error;
+    ubyte2 prof_max_us[PROF_NUM_SECTIONS];
+    ubyte2 prof_mean_count[PROF_NUM_SECTIONS];
+} TELEM_PACKET;
+
+static TELEM_PACKET telem_packet;
+static ubyte2 telem_socket;
+static bool   telem_ready;
+static ubyte4 telem_dropped;
+
+/**************************************************************************************************
+ * Functions
+ *************************************************************************************************/
+
+IO_ErrorType TELEM_Init(void)
+{
+    IO_ErrorType io_error;
+
+    telem_ready   = FALSE;
+    telem_dropped = 0;
+
+    io_error = IO_UDP_Init(IO_ETH_SPEED_100_MB,
+                           (const ubyte1 *)TELEM_LOCAL_IP,
+                           (const ubyte1 *)TELEM_PC_IP);
+    if (io_error != IO_E_OK)
+    {
+        return io_error;
+    }
+    io_error = IO_UDP_CreateSocket(IO_UDP_WRITE,
+                                   TELEM_PORT,
+                                   (const ubyte1 *)TELEM_LOCAL_IP,
+                                   &telem_socket);
+    if (io_error != IO_E_OK)
+    {
+        return io_error;
+    }
+
+    /* header part never changes again */
+    telem_packet.magic    = TELEM_PACKET_MAGIC;
+    telem_packet.version  = TELEM_PACKET_VERSION;
+    telem_packet.reserved = 0;
+    telem_packet.sequence = 0;
+
+    telem_ready = TRUE;
+    return IO_E_OK;
+}
+
+void TELEM_Send(ubyte4 tick, ubyte2 torque, const PID_STATE * const pid)
+{
+    ubyte1 i;
+
+    if (telem_ready == FALSE)
+    {
+        return;
+    }
+
+    telem_packet.sequence++;
+    telem_packet.tick = tick;
+    for (i = 0; i < ADC_SCAN_NUM_CHANNELS; i++)
+    {
+        telem_packet.ai[i] = (ubyte2)ADC_SCAN_values[i];
+    }
+    telem_packet.ai_fresh           = ADC_SCAN_fresh;
+    telem_packet.di                 = DI_SCAN_State();
+    telem_packet.torque             = torque;
+    telem_packet.pid_integral_q16   = pid->integral_q16;
+    telem_packet.pid_previous_error = pid->previous_error;
+    for (i = 0; i < PROF_NUM_SECTIONS; i++)
+    {
+        const PROF_STATS * stats = PROF_GetStats(i);
+
+        telem_packet.prof_max_us[i]     = stats->max_us;
+        telem_packet.prof_mean_count[i] = stats->count;
+    }
+
+    if (IO_UDP_WriteTo(telem_socket,
+                       (const ubyte1 *)&telem_packet,
+                       sizeof(telem_packet),
+                       TELEM_PORT,
+                       (const ubyte1 *)TELEM_TARGET_IP) != IO_E_OK)
+    {
+        telem_dropped++;
+    }
+}
+
+ubyte4 TELEM_DroppedPackets(void)
+{
+    return telem_dropped;
+}
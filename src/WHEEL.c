@@ -0,0 +1,103 @@
+/**************************************************************************************************
+ * Name
+ *    WHEEL.c
+ *
+ * Purpose
+ *    Wheel speed acquisition on the PWD timer inputs, see WHEEL.h.
+ *************************************************************************************************/
+
+#include "WHEEL.h"
+#include "BOARD.h"
+
+/**************************************************************************************************
+ * Static data
+ *************************************************************************************************/
+
+/* pin assignments come from the board layer (BOARD_pwd_channels) */
+
+static sbyte4 wheel_speed_q16[WHEEL_NUM_CHANNELS];
+static bool   wheel_valid[WHEEL_NUM_CHANNELS];
+
+/**************************************************************************************************
+ * Functions
+ *************************************************************************************************/
+
+IO_ErrorType WHEEL_Init(void)
+{
+    IO_ErrorType io_error = IO_E_OK;
+    ubyte1 i;
+
+    for (i = 0; i < WHEEL_NUM_CHANNELS; i++)
+    {
+        IO_ErrorType channel_error;
+
+        channel_error = IO_PWD_ComplexInit(BOARD_pwd_channels[i],
+                                           IO_PWD_HIGH_TIME,    /* capture high time       */
+                                           IO_PWD_FALLING_VAR,  /* falling edge variable   */
+                                           4,                   /* accumulate 4 captures   */
+                                           IO_PWD_PU_10K,       /* pull up for open drain  */
+                                           NULL);
+        if (channel_error != IO_E_OK)
+        {
+            io_error = channel_error;   /* report the last failing channel */
+        }
+        wheel_speed_q16[i] = 0;
+        wheel_valid[i]     = FALSE;
+    }
+    return io_error;
+}
+
+void WHEEL_Read(void)
+{
+    ubyte1 i;
+
+    for (i = 0; i < WHEEL_NUM_CHANNELS; i++)
+    {
+        ubyte4 frequency_mhz = 0;   /* accumulated frequency in mHz */
+        ubyte4 pulse_width   = 0;
+        bool   pin_value     = FALSE;
+        IO_PWD_PULSE_SAMPLES pulse_samples;
+        IO_ErrorType io_error;
+
+        io_error = IO_PWD_ComplexGet(BOARD_pwd_channels[i],
+                                     &frequency_mhz,
+                                     &pulse_width,
+                                     &pin_value,
+                                     &pulse_samples);
+        if (io_error == IO_E_OK)
+        {
+            /* mHz -> rpm in Q16: rpm = f[Hz] * 60 / pulses_per_rev
+             *                        = f[mHz] * 60 / (1000 * pulses_per_rev) */
+            wheel_speed_q16[i] = (sbyte4)(((sbyte8)frequency_mhz * 65536 * 60)
+                                          / (1000 * WHEEL_PULSES_PER_REV));
+            wheel_valid[i] = TRUE;
+        }
+        else if (io_error == IO_E_PWD_NOT_FINISHED)
+        {
+            /* no edges in the measurement window: the wheel stands, and the
+             * torque PID must see 0, not the last speed before the stop */
+            wheel_speed_q16[i] = 0;
+            wheel_valid[i]     = TRUE;
+        }
+        else
+        {
+            /* capture fault: keep the last speed, flag it stale */
+            wheel_valid[i] = FALSE;
+        }
+    }
+}
+
+sbyte4 WHEEL_Speed(ubyte1 wheel)
+{
+    return wheel_speed_q16[wheel];
+}
+
+sbyte4 WHEEL_VehicleSpeed(void)
+{
+    return (wheel_speed_q16[WHEEL_IDX_AXLE_1] + wheel_speed_q16[WHEEL_IDX_AXLE_2]) / 2;
+}
+
+bool WHEEL_IsValid(ubyte1 wheel)
+{
+    return wheel_valid[wheel];
+}
@@ -0,0 +1,272 @@
+/**************************************************************************************************
+ * Name
+ *    BENCH.c
+ *
+ * Purpose
+ *    On-target microbenchmarks for the I/O driver calls the application leans on.
+ *
+ *    Builds as its own application with `make bench TARGET=...` and prints per-call costs over
+ *    the debug UART. Each benchmark is a tight loop bracketed by IO_RTC_StartTime()/
+ *    IO_RTC_GetTimeUS(); the asynchronous EEPROM and flash operations additionally report the
+ *    busy-wait time until completion. Rerun after every BSP update -- the numbers are the
+ *    baseline every optimization request is judged against.
+ *************************************************************************************************/
+
+/**************************************************************************************************
+ * Includes
+ *************************************************************************************************/
+#include <stdio.h>
+
+#include "APDB.h"
+#include "IO_Driver.h"
+#include "IO_RTC.h"
+#include "IO_DEBUG.h"
+#include "IO_ADC.h"
+#include "IO_DIO.h"
+#include "IO_CAN.h"
+#include "IO_EEPROM.h"
+#include "IO_FLASH.h"
+#include "ptypes_apdb.h"
+#include "ptypes_tms570.h"
+
+/**************************************************************************************************
+ * Defines
+ *************************************************************************************************/
+
+/* iterations per benchmarked call (RAM/register paths are fast, keep the run short) */
+#define BENCH_LOOPS             1000
+
+/* bytes moved per EEPROM / flash benchmark */
+#define BENCH_EEPROM_BYTES      16
+#define BENCH_FLASH_BYTES       256
+
+/* scratch offsets: EEPROM well above the parameter block, flash in the first 8 KiB block
+ * (the flight recorder region starts at 0x010000) */
+#define BENCH_EEPROM_OFFSET     0x0F00
+#define BENCH_FLASH_OFFSET      0x000000
+
+/**************************************************************************************************
+ * Application Database,
+ * needed for TTC-Downloader
+ *************************************************************************************************/
+#pragma SET_DATA_SECTION (".APDB_SEC")
+volatile const BL_APDB Apdb_t =
+{
+    APDB_VERSION,           /* APDB version                                        */
+    {0},                    /* Flash date (provided by TTC-Downloader)             */
+                            /* Build date                                          */
+    {((((RTS_TTC_FLASH_DATE_YEAR)   & 0x0FFF) <<  0) |
+      (((RTS_TTC_FLASH_DATE_MONTH)  & 0x0F  ) << 12) |
+      (((RTS_TTC_FLASH_DATE_DAY)    & 0x1F  ) << 16) |
+      (((RTS_TTC_FLASH_DATE_HOUR)   & 0x1F  ) << 21) |
+      (((RTS_TTC_FLASH_DATE_MINUTE) & 0x3F  ) << 26))},
+    0,                      /* Node type                                           */
+    0,                      /* CRC start address (provided by TTC-Downloader)      */
+    0,                      /* code size (provided by TTC-Downloader)              */
+    0,                      /* Legacy application CRC (provided by TTC-Downloader) */
+    0,                      /* Application CRC (provided by TTC-Downloader)        */
+    1,                      /* Node number                                         */
+    0,                      /* CRC seed (provided by TTC-Downloader)               */
+    0,                      /* Flags                                               */
+    0,                      /* Hook 1                                              */
+    0,                      /* Hook 2                                              */
+    0,                      /* Hook 3                                              */
+    APPL_START,             /* Main address, i.e., application entry point         */
+    {0, 1},                 /* CAN download ID (standard format, ID 0x1)           */
+    {0, 2},                 /* CAN upload ID (standard format, ID 0x2)             */
+    0,                      /* Legacy header CRC (provided by TTC-Downloader)      */
+    0,                      /* Application version                                 */
+    250,                    /* CAN baud rate in kbps                               */
+    0,                      /* CAN channel                                         */
+    0,                      /* Password (disable password protection)              */
+    0,                      /* Magic seed                                          */
+    { 10, 100,  30, 200},   /* Target IP address                                   */
+    {255, 255,   0,   0},   /* Subnet mask                                         */
+    {239,   0,   0,   1},   /* Multicast IP address                                */
+    0,                      /* Debug key                                           */
+    0,                      /* Automatic baud rate detection timeout               */
+    0x00,                   /* Manufacturer ID                                     */
+    0x00,                   /* Application ID                                      */
+    {0},                    /* Reserved, must be set to zero                       */
+    0                       /* Header CRC (provided by TTC-Downloader)             */
+};
+
+#pragma SET_DATA_SECTION()
+
+/**************************************************************************************************
+ * Static data
+ *************************************************************************************************/
+
+static ubyte1 bench_buffer[BENCH_FLASH_BYTES];
+
+/**************************************************************************************************
+ * Functions
+ *************************************************************************************************/
+
+/* prints one result line: total runtime and cost per call in ns */
+static void BENCH_Print(const char * name, ubyte4 elapsed_us, ubyte4 loops)
+{
+    printf("%-20s %8lu us total  %8lu ns/call\r\n",
+           name,
+           (unsigned long)elapsed_us,
+           (unsigned long)((elapsed_us * 1000u) / loops));
+}
+
+static void BENCH_AdcGet(void)
+{
+    ubyte4 start;
+    ubyte4 value = 0;
+    bool   fresh = FALSE;
+    ubyte4 i;
+
+    (void)IO_ADC_ChannelInit(IO_ADC_00, IO_ADC_CURRENT, IO_ADC_NO_RANGE,
+                             IO_ADC_NO_PULL, IO_PIN_NONE, NULL);
+    (void)IO_RTC_StartTime(&start);
+    for (i = 0; i < BENCH_LOOPS; i++)
+    {
+        (void)IO_ADC_Get(IO_ADC_00, &value, &fresh);
+    }
+    BENCH_Print("IO_ADC_Get", IO_RTC_GetTimeUS(start), BENCH_LOOPS);
+}
+
+static void BENCH_DiGet(void)
+{
+    ubyte4 start;
+    bool   value = FALSE;
+    ubyte4 i;
+
+    (void)IO_DI_Init(IO_DI_58, IO_DI_PU_10K, NULL);
+    (void)IO_RTC_StartTime(&start);
+    for (i = 0; i < BENCH_LOOPS; i++)
+    {
+        (void)IO_DI_Get(IO_DI_58, &value);
+    }
+    BENCH_Print("IO_DI_Get", IO_RTC_GetTimeUS(start), BENCH_LOOPS);
+}
+
+static void BENCH_DoSet(void)
+{
+    ubyte4 start;
+    ubyte4 i;
+
+    (void)IO_DO_Init(IO_DO_16, FALSE, NULL);
+    (void)IO_RTC_StartTime(&start);
+    for (i = 0; i < BENCH_LOOPS; i++)
+    {
+        (void)IO_DO_Set(IO_DO_16, (bool)(i & 1u));
+    }
+    BENCH_Print("IO_DO_Set", IO_RTC_GetTimeUS(start), BENCH_LOOPS);
+    (void)IO_DO_Set(IO_DO_16, FALSE);
+}
+
+static void BENCH_CanWriteMsg(void)
+{
+    IO_CAN_DATA_FRAME frame = {0};
+    ubyte2 handle_w;
+    ubyte4 start;
+    ubyte4 i;
+
+    (void)IO_CAN_Init(IO_CAN_CHANNEL_1, IO_CAN_BIT_250_KB, 0, 0, 0, 0);
+    (void)IO_CAN_ConfigMsg(&handle_w, IO_CAN_CHANNEL_1, IO_CAN_MSG_WRITE,
+                           IO_CAN_STD_FRAME, 0, 0);
+    frame.id        = 0x7FF;
+    frame.id_format = IO_CAN_STD_FRAME;
+    frame.length    = 8;
+
+    /* measures the call itself: the message object is busy most iterations, which is
+     * exactly the path the application hits when it polls a loaded bus */
+    (void)IO_RTC_StartTime(&start);
+    for (i = 0; i < BENCH_LOOPS; i++)
+    {
+        (void)IO_CAN_WriteMsg(handle_w, &frame);
+    }
+    BENCH_Print("IO_CAN_WriteMsg", IO_RTC_GetTimeUS(start), BENCH_LOOPS);
+}
+
+static void BENCH_EepromRead(void)
+{
+    ubyte4 start;
+    ubyte4 call_us;
+
+    /* trigger cost: the read is asynchronous */
+    (void)IO_RTC_StartTime(&start);
+    (void)IO_EEPROM_Read(BENCH_EEPROM_OFFSET, BENCH_EEPROM_BYTES, bench_buffer);
+    call_us = IO_RTC_GetTimeUS(start);
+    BENCH_Print("IO_EEPROM_Read", call_us, 1);
+
+    /* completion cost: busy-wait like PARAM_Init() does at startup */
+    (void)IO_RTC_StartTime(&start);
+    while (IO_EEPROM_GetStatus() == IO_E_BUSY)
+    {
+    }
+    BENCH_Print("  EEPROM busy-wait", IO_RTC_GetTimeUS(start), 1);
+}
+
+static void BENCH_FlashWrite(void)
+{
+    ubyte4 start;
+    ubyte4 i;
+
+    (void)IO_FLASH_Init();
+    while (IO_FLASH_GetStatus() == IO_E_BUSY)
+    {
+    }
+    for (i = 0; i < BENCH_FLASH_BYTES; i++)
+    {
+        bench_buffer[i] = (ubyte1)i;
+    }
+
+    /* erase the scratch block first, flash can only clear bits */
+    (void)IO_FLASH_BlockErase(BENCH_FLASH_OFFSET);
+    while (IO_FLASH_GetStatus() == IO_E_BUSY)
+    {
+    }
+
+    /* trigger cost: the write is asynchronous */
+    (void)IO_RTC_StartTime(&start);
+    (void)IO_FLASH_Write(BENCH_FLASH_OFFSET, BENCH_FLASH_BYTES, bench_buffer);
+    BENCH_Print("IO_FLASH_Write", IO_RTC_GetTimeUS(start), 1);
+
+    /* completion cost */
+    (void)IO_RTC_StartTime(&start);
+    while (IO_FLASH_GetStatus() == IO_E_BUSY)
+    {
+    }
+    BENCH_Print("  FLASH busy-wait", IO_RTC_GetTimeUS(start), 1);
+}
+
+/* ============================================================================================= */
+/*    Function Name:          main                                                               */
+/* ============================================================================================= */
+
+#pragma TASK( main );
+void main(void)
+{
+    IO_ErrorType io_error;
+
+    /* no safety configuration: the benchmarks must see raw driver cost */
+    io_error = IO_Driver_Init(NULL);
+    (void)io_error;
+    (void)IO_DEBUG_StdioInit();
+
+    (void)IO_Driver_TaskBegin();
+
+    printf("\r\nHY-TTC 500 driver microbenchmarks (%u loops)\r\n", BENCH_LOOPS);
+    printf("----------------------------------------------\r\n");
+    BENCH_AdcGet();
+    BENCH_DiGet();
+    BENCH_DoSet();
+    BENCH_CanWriteMsg();
+    BENCH_EepromRead();
+    BENCH_FlashWrite();
+    printf("----------------------------------------------\r\ndone.\r\n");
+
+    (void)IO_Driver_TaskEnd();
+
+    while (1)
+    {
+        (void)IO_Driver_TaskBegin();
+        (void)IO_Driver_TaskEnd();
+    }
+
+} /* END OF main */
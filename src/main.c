@@ -29,6 +29,29 @@
 #include "ptypes_tms570.h"
 
 #include "PID.h"
+#include "CAN_TX.h"
+#include "CAN_SCHED.h"
+#include "ADC_SCAN.h"
+#include "DI_SCAN.h"
+#include "SCHED.h"
+#include "CAN_MSG.h"
+#include "CAN_GW.h"
+#include "J1939.h"
+#include "PROF.h"
+#include "MPU_GUARD.h"
+#include "PARAM.h"
+#include "FLREC.h"
+#include "WHEEL.h"
+#include "TELEM.h"
+#include "DO_OUT.h"
+#include "LIN.h"
+#include "DIAG_LOG.h"
+#include "PWM_OUT.h"
+#include "SNAP.h"
+#include "FWUP.h"
+#include "CONS.h"
+#include "ODO.h"
+#include "IO_DOWNLOAD.h"
 
 /**************************************************************************************************
  * Defines
@@ -38,6 +61,9 @@
 #define MINOR_NUMBER            0
 #define REVISION_NUMBER         0
 
+/* depth of the CAN 2 receive FIFO for the inverter frames (driver allows 2..63) */
+#define CAN2_RX_FIFO_SIZE       16
+
 /**************************************************************************************************
  * Static data
  *************************************************************************************************/
@@ -113,38 +139,25 @@ static void APPL_FPUhandler(bool division_by_zero,
 /**************************************************************************************************
  * Global Variables
  *************************************************************************************************/
-{
-ubyte4 AI_103; //датчик температуры НН
-ubyte4 AI_127; //датчик температуры ВН
-ubyte4 AI_104; //датчик давления РТС 1-го моста
-ubyte4 AI_128; //датчик давления РТС 2-го моста
-ubyte4 AI_105; //датчик температуры обмотки статора №1
-ubyte4 AI_129; //датчик температуры обмотки статора №2
-ubyte4 AI_106; //датчик температуры обмотки статора №3
-ubyte4 AI_130; //датчик температуры обмотки статора №4
-ubyte4 AI_107; //датчик температуры обмотки статора №5
-ubyte4 AI_131; //датчик температуры обмотки статора №6
-bool adc_00;
-bool adc_01;
-bool adc_02;
-bool adc_03;
-bool adc_04;
-bool adc_05;
-bool adc_06;
-bool adc_07;
-bool adc_08;
-bool adc_09;
-bool DI_108; //Редуктор полуприцепа
-bool DI_132; //Датчик БМКД 1-го моста
-bool DI_109; //Датчик БМКД 2-го моста
-bool DI_133; //Датчик задней передачи
-bool DI_110; //Датчик пониженной передачи
-bool DI_134; //Чек контакт тэд
-bool DI_111; //Чек контакт вентилятора
-bool DI_135; //Чек контакт тока 1
-bool DI_112; //Чек контакт тока 2
-bool DI_136; //Чек контакт тока 3
-bool DI_113; //Чек ФОРСАЖ
+IO_ErrorType io_error = IO_E_OK;
+//AI_103..AI_131 живут в упакованном массиве ADC_SCAN_values (см. ADC_SCAN.h)
+//DI_108..DI_136 живут в упакованном слове DI_SCAN_State() (см. DI_SCAN.h)
+//СИГНАЛЫ ДЛЯ MTU-SENSORS-1/2
+ubyte1 temp_n;
+ubyte1 temp_v;
+ubyte1 PTC_1;
+ubyte1 PTC_2;
+ubyte1 RP;
+ubyte1 BMKD_1;
+ubyte1 BMKD_2;
+ubyte1 RG;
+ubyte1 LG;
+ubyte1 TED;
+ubyte1 FAN;
+ubyte1 K1;
+ubyte1 K2;
+ubyte1 K3;
+ubyte1 F;
 //bool DO_153 - DO_16;
 //bool DO_177 - DO_17;
 //bool DO_156 - DO_18;
@@ -152,253 +165,393 @@ bool DI_113; //Чек ФОРСАЖ
 //bool DO_159 - DO_20;
 ubyte2 handle1_w;
 ubyte2 handle2_w;
-ubyte2 handle_r_m;
-ubyte2 handle_r_e;
-ubyte2 handle_r_t;
+ubyte2 handle_r_fifo; //FIFO для всех кадров инвертора
+ubyte4 can2_rx_overflow; //счётчик переполнений FIFO
 ubyte2 handle3_w;
 ubyte2 handle4_w;
-ubyte1 kp;
-ubyte1 ki;
-ubyte1 kd;
+//kp/ki/kd живут в энергонезависимом хранилище параметров (см. PARAM.h)
 ubyte2 Torque;
-}
+PID_STATE pid_torque; //регулятор ТЭД
 
 /**************************************************************************************************
  * Functions
  *************************************************************************************************/
 
-void Initialization(){
-    {//ADC SETTINGS
-    io_error = IO_ADC_ChannelInit(IO_ADC_00,       /* measure 103 pin */
-                                  IO_ADC_CURRENT,  /* absolute measurement type */
-                                  IO_ADC_NO_RANGE,  /* range is fixed for this type */
-                                  IO_ADC_NO_PULL,   /* pull resistor is fixed for this type */
-                                  IO_PIN_NONE,      /* no sensor supply */
-                                  NULL);
-    io_error = IO_ADC_ChannelInit(IO_ADC_01,       
-                                  IO_ADC_CURRENT,  
-                                  IO_ADC_NO_RANGE,  
-                                  IO_ADC_NO_PULL,   
-                                  IO_PIN_NONE,      
-                                  NULL);
-    io_error = IO_ADC_ChannelInit(IO_ADC_02,      
-                                  IO_ADC_CURRENT,  
-                                  IO_ADC_NO_RANGE,  
-                                  IO_ADC_NO_PULL,   
-                                  IO_PIN_NONE,      
-                                  NULL);
-    io_error = IO_ADC_ChannelInit(IO_ADC_03,      
-                                  IO_ADC_CURRENT,  
-                                  IO_ADC_NO_RANGE,  
-                                  IO_ADC_NO_PULL,  
-                                  IO_PIN_NONE,     
-                                  NULL);
-    io_error = IO_ADC_ChannelInit(IO_ADC_04,      
-                                  IO_ADC_ABSOLUTE,  
-                                  IO_ADC_RANGE_10V,  
-                                  IO_ADC_NO_PULL,   
-                                  IO_PIN_NONE,      
-                                  NULL);
-    io_error = IO_ADC_ChannelInit(IO_ADC_05,      
-                                  IO_ADC_ABSOLUTE,  
-                                  IO_ADC_RANGE_10V,  
-                                  IO_ADC_NO_PULL,  
-                                  IO_PIN_NONE,     
-                                  NULL);
-    io_error = IO_ADC_ChannelInit(IO_ADC_06,      
-                                  IO_ADC_ABSOLUTE,  
-                                  IO_ADC_RANGE_10V,  
-                                  IO_ADC_NO_PULL,   
-                                  IO_PIN_NONE,      
-                                  NULL);
-    io_error = IO_ADC_ChannelInit(IO_ADC_07,      
-                                  IO_ADC_ABSOLUTE,  
-                                  IO_ADC_RANGE_10V,  
-                                  IO_ADC_NO_PULL,  
-                                  IO_PIN_NONE,     
-                                  NULL);
-    io_error = IO_ADC_ChannelInit(IO_ADC_08,      
-                                  IO_ADC_ABSOLUTE,  
-                                  IO_ADC_RANGE_10V,  
-                                  IO_ADC_NO_PULL,   
-                                  IO_PIN_NONE,      
-                                  NULL);
-    io_error = IO_ADC_ChannelInit(IO_ADC_09,      
-                                  IO_ADC_ABSOLUTE,  
-                                  IO_ADC_RANGE_10V,  
-                                  IO_ADC_NO_PULL,  
-                                  IO_PIN_NONE,     
-                                  NULL);
+/* pack functions generated from the message tables in CAN_MSG.h */
+CAN_MSG_DEFINE_PACK(MTU_SENSORS_1)
+CAN_MSG_DEFINE_PACK(MTU_SENSORS_2)
+
+/* J1939 address of the inverter and the diagnostic PGN it broadcasts over TP.BAM */
+#define INV_SOURCE_ADDR  0xC0u
+#define INV_PGN_DM1      0xFECAu    /* active diagnostic trouble codes */
+
+//последний принятый диагностический пакет инвертора (DM1, собирается из TP.BAM)
+static ubyte1 inv_dm1[J1939_TP_MAX_SIZE];
+static ubyte2 inv_dm1_len;
+static ubyte4 inv_dm1_updates;
+
+static void InvDiagHandler(ubyte4 pgn, const ubyte1 * data, ubyte2 length){
+    ubyte2 i;
+
+    (void)pgn; //one PGN in the table, see inv_handlers
+    for (i = 0; i < length; i++){
+        inv_dm1[i] = data[i];
     }
-    {//DI SETTINGS
-    io_error = IO_DI_Init(IO_DI_58, IO_DI_PU_10K, NULL);
-    io_error = IO_DI_Init(IO_DI_59, IO_DI_PU_10K, NULL);
-    io_error = IO_DI_Init(IO_DI_60, IO_DI_PU_10K, NULL);
-    io_error = IO_DI_Init(IO_DI_61, IO_DI_PU_10K, NULL);
-    io_error = IO_DI_Init(IO_DI_62, IO_DI_PU_10K, NULL);
-    io_error = IO_DI_Init(IO_DI_63, IO_DI_PU_10K, NULL);
-    io_error = IO_DI_Init(IO_DI_64, IO_DI_PU_10K, NULL);
-    io_error = IO_DI_Init(IO_DI_65, IO_DI_PU_10K, NULL);
-    io_error = IO_DI_Init(IO_DI_66, IO_DI_PU_10K, NULL);
-    io_error = IO_DI_Init(IO_DI_67, IO_DI_PU_10K, NULL);
-    io_error = IO_DI_Init(IO_DI_68, IO_DI_PU_10K, NULL);
+    inv_dm1_len = length;
+    inv_dm1_updates++;
+}
+
+/* dense handler table: slot i serves PGN (INV_PGN_DM1 + i) */
+static const J1939_HANDLER inv_handlers[] =
+{
+    &InvDiagHandler,
+};
+
+/* inverter-to-MTU routing: one line per gatewayed identifier */
+static const CAN_GW_ROUTE can2_routes[] =
+{
+    /* match id    match mask   destination  id rewrite      format rewrite      latency section         */
+    { 0x0CFFE1C0, 0x1FFFFFFF, &handle2_w, CAN_GW_KEEP_ID, CAN_GW_KEEP_FORMAT, PROF_SECTION_GW_ROUTE_0 }, // inv_sensors_m
+    { 0x0CFFE2C0, 0x1FFFFFFF, &handle2_w, CAN_GW_KEEP_ID, CAN_GW_KEEP_FORMAT, PROF_SECTION_GW_ROUTE_1 }, // inv_sensors_e
+    { 0x0CFFE3C0, 0x1FFFFFFF, &handle2_w, CAN_GW_KEEP_ID, CAN_GW_KEEP_FORMAT, PROF_SECTION_GW_ROUTE_2 }, // inv_sensors_t
+};
+#define CAN2_ROUTE_COUNT ((ubyte1)(sizeof(can2_routes)/sizeof(can2_routes[0])))
+
+/* critical path only: everything the torque loop and the inverter link need before the
+ * first control cycle -- the remaining channels come up in InitStaged() during the slack
+ * of the first cycles */
+void Initialization(){
+    PROF_Init();
+    PROF_Begin(PROF_SECTION_BOOT); //boot-to-ready time, PROF_End in the last init stage
+    io_error = MPU_GUARD_Init(); // аппаратная защита буферов, нарушение -> APPL_ErrorCb
+    CAN_TX_Init();
+    CAN_SCHED_Init();
+    DIAG_LOG_Init();
+    SNAP_Init();
+    {//DO SETTINGS (channel table lives in DO_OUT.c), БСКР сразу в выключенное
+    io_error = DO_OUT_Init();
     }
-    {//DO SETTINGS
-    io_error = IO_DO_Init(IO_DO_16, FALSE, NULL);
-    io_error = IO_DO_Init(IO_DO_17, FALSE, NULL);
-    io_error = IO_DO_Init(IO_DO_18, FALSE, NULL);
-    io_error = IO_DO_Init(IO_DO_19, FALSE, NULL);
-    io_error = IO_DO_Init(IO_DO_20, FALSE, NULL);
+    {//PWM SETTINGS (channel table lives in PWM_OUT.c), реле ТЭД и вентилятор через ШИМ
+    io_error = PWM_OUT_Init();
     }
-    {//CAN_1 SETTENGS
-    io_error = IO_CAN_Init(IO_CAN_CHANNEL_1,        /* CAN channel */
+    {//CAN_2 SETTENGS (inverter link, must be up before the first cycle)
+    io_error = IO_CAN_Init(IO_CAN_CHANNEL_2,        /* CAN channel */
                               IO_CAN_BIT_250_KB,       /* 250 kBit/s */
                               0,                       /* default */
                               0,                       /* default */
                               0,                       /* default */
                               0);                      /* default */
 
-    io_error = IO_CAN_ConfigMsg(&handle1_w,
-                                IO_CAN_CHANNEL_1, // channel 1
+    io_error = IO_CAN_ConfigMsg(&handle2_w,
+                                IO_CAN_CHANNEL_2, // channel 2
                                 IO_CAN_MSG_WRITE, // transmit message buffer
                                 IO_CAN_STD_FRAME, // standard ID
                                 0,
                                 0);
+    io_error = CAN_TX_Register(handle2_w); // software TX queue over handle2_w
+    io_error = IO_CAN_ConfigFIFO(&handle_r_fifo, // one FIFO instead of three single-message buffers
+                                 IO_CAN_CHANNEL_2, // channel 2
+                                 CAN2_RX_FIFO_SIZE, // a whole burst fits between two polls
+                                 IO_CAN_EXT_FRAME, // 29-bit J1939 IDs (was STD_FRAME, which never matched)
+                                 INV_SOURCE_ADDR,
+                                 0x000000FF); // source address only: sensor PGNs plus TP.CM/TP.DT from the inverter
+    J1939_Init(INV_PGN_DM1, inv_handlers, // O(1) PGN dispatch + TP.BAM reassembly
+               (ubyte1)(sizeof(inv_handlers)/sizeof(inv_handlers[0])),
+               INV_SOURCE_ADDR);
     }
-    {//CAN_2 SETTENGS
-    io_error = IO_CAN_Init(IO_CAN_CHANNEL_2,        /* CAN channel */
+    io_error = IO_POWER_Set(IO_INT_POWERSTAGE_ENABLE, IO_POWER_ON);
+    io_error = IO_POWER_Set(IO_INT_SAFETY_SW_0, IO_POWER_ON);
+
+    /* gains survive power cycles in the EEPROM parameter block; the blocking read stays on
+     * the critical path because the torque loop cannot close without them */
+    io_error = PARAM_Init();
+
+    /* output is a Q16 coefficient 0..1 which scales the torque demand */
+    PID_Init(&pid_torque,
+             PID_Q16(PARAM_Get(PARAM_ID_KP)),
+             PID_Q16(PARAM_Get(PARAM_ID_KI)),
+             PID_Q16(PARAM_Get(PARAM_ID_KD)),
+             SCHED_TICK_US,             /* torque task runs every tick */
+             0, PID_Q16_ONE);
+}
+
+/* one init stage per entry, executed one per tick by InitStaged() */
+static void InitStage_CAN1(){
+    io_error = IO_CAN_Init(IO_CAN_CHANNEL_1,        /* CAN channel */
                               IO_CAN_BIT_250_KB,       /* 250 kBit/s */
                               0,                       /* default */
                               0,                       /* default */
                               0,                       /* default */
                               0);                      /* default */
 
-    io_error = IO_CAN_ConfigMsg(&handle2_w,
-                                IO_CAN_CHANNEL_2, // channel 2
+    io_error = IO_CAN_ConfigMsg(&handle1_w,
+                                IO_CAN_CHANNEL_1, // channel 1
                                 IO_CAN_MSG_WRITE, // transmit message buffer
                                 IO_CAN_STD_FRAME, // standard ID
                                 0,
                                 0);
-    io_error = IO_CAN_ConfigMsg(&handle_r_m, // read inv_sensors_m message
-                                IO_CAN_CHANNEL_2, // channel 2
-                                IO_CAN_MSG_READ, // read message buffer
-                                IO_CAN_STD_FRAME, // standard ID
-                                0x0CFFE1C0,
-                                0x1FFFFFFF); // check all
-    io_error = IO_CAN_ConfigMsg(&handle_r_e, // read inv_sensors_e message
-                                IO_CAN_CHANNEL_2, // channel 2
-                                IO_CAN_MSG_READ, // read message buffer
-                                IO_CAN_STD_FRAME, // standard ID
-                                0x0CFFE2C0,
-                                0x1FFFFFFF); // check all
-    io_error = IO_CAN_ConfigMsg(&handle_r_t, // read inv_sensors_t message
-                                IO_CAN_CHANNEL_2, // channel 2
-                                IO_CAN_MSG_READ, // read message buffer
-                                IO_CAN_STD_FRAME, // standard ID
-                                0x0CFFE3C0,
-                                0x1FFFFFFF); // check all
+    io_error = CAN_TX_Register(handle1_w); // software TX queue over handle1_w
+
+    //MTU-SENSORS-1/2 раз в 10 мс, фазы разнесены, чтобы не было пачки в начале слота
+    io_error = CAN_SCHED_Add(handle1_w, CAN_MSG_MTU_SENSORS_1_ID,
+                             10, 0, 5, &CAN_MSG_Pack_MTU_SENSORS_1);
+    io_error = CAN_SCHED_Add(handle1_w, CAN_MSG_MTU_SENSORS_2_ID,
+                             10, 2, 5, &CAN_MSG_Pack_MTU_SENSORS_2);
+}
+static void InitStage_ADC(){
+    io_error = ADC_SCAN_Init(); //channel table lives in ADC_SCAN.c
+}
+static void InitStage_DI(){
+    io_error = DI_SCAN_Init(); //channel table lives in DI_SCAN.c
+}
+static void InitStage_WHEEL(){
+    io_error = WHEEL_Init(); //timer inputs, channel table lives in WHEEL.c
+}
+static void InitStage_FLREC(){
+    io_error = FLREC_Init(); //flight recorder on the external flash
+}
+static void InitStage_TELEM(){
+    io_error = TELEM_Init(); //UDP telemetry multicast on the Ethernet interface
+}
+static void InitStage_CONS(){
+    io_error = CONS_Init(); //сервисная консоль на UART, см. CONS.h
+}
+static void InitStage_FWUP(){
+    io_error = FWUP_Init(); //firmware staging socket (Ethernet is up since the TELEM stage)
+    io_error = IO_DOWNLOAD_Init(); //TTC-Downloader requests over Ethernet
+}
+static void InitStage_ODO(){
+    io_error = ODO_Init(); //моточасы и счётчики событий, журнал в EEPROM
+    PROF_End(PROF_SECTION_BOOT); //last stage: boot time shows up in the first report
+}
+
+/* FLREC before the first LogRecord() run (tick 8), everything else before the first
+ * Housekeeping() run (tick 7) -- except ODO at tick 8, whose task is a no-op until
+ * ODO_Init ran */
+static void (* const init_stages[])() =
+{
+    &InitStage_CAN1,
+    &InitStage_ADC,
+    &InitStage_DI,
+    &InitStage_WHEEL,
+    &InitStage_FLREC,
+    &InitStage_TELEM,
+    &InitStage_CONS,
+    &InitStage_FWUP,
+    &InitStage_ODO,
+};
+#define INIT_STAGE_COUNT ((ubyte1)(sizeof(init_stages)/sizeof(init_stages[0])))
+
+void InitStaged(){//1 ms rate group: one stage per tick during the early cycle slack
+    static ubyte1 init_stage = 0;
+
+    if (init_stage < INIT_STAGE_COUNT){
+        init_stages[init_stage]();
+        init_stage++;
     }
-    io_error = IO_POWER_Set(IO_INT_POWERSTAGE_ENABLE, IO_POWER_ON);
-    io_error = IO_POWER_Set(IO_INT_SAFETY_SW_0, IO_POWER_ON);
 }
 void Sensors(){
-    io_error = IO_ADC_Get(IO_ADC_00, &AI_103, &adc_00);
-    io_error = IO_ADC_Get(IO_ADC_01, &AI_127, &adc_01);
-    io_error = IO_ADC_Get(IO_ADC_02, &AI_104, &adc_02);
-    io_error = IO_ADC_Get(IO_ADC_03, &AI_128, &adc_03);
-    io_error = IO_ADC_Get(IO_ADC_04, &AI_105, &adc_04);
-    io_error = IO_ADC_Get(IO_ADC_05, &AI_129, &adc_05);
-    io_error = IO_ADC_Get(IO_ADC_06, &AI_106, &adc_06);
-    io_error = IO_ADC_Get(IO_ADC_07, &AI_130, &adc_07);
-    io_error = IO_ADC_Get(IO_ADC_08, &AI_107, &adc_08);
-    io_error = IO_ADC_Get(IO_ADC_09, &AI_131, &adc_09);
-
-    io_error = IO_DI_Get(IO_DI_58, &DI_108);
-    io_error = IO_DI_Get(IO_DI_59, &DI_132);
-    io_error = IO_DI_Get(IO_DI_60, &DI_109);
-    io_error = IO_DI_Get(IO_DI_61, &DI_133);
-    io_error = IO_DI_Get(IO_DI_62, &DI_110);
-    io_error = IO_DI_Get(IO_DI_63, &DI_134);
-    io_error = IO_DI_Get(IO_DI_64, &DI_111);
-    io_error = IO_DI_Get(IO_DI_65, &DI_135);
-    io_error = IO_DI_Get(IO_DI_66, &DI_112);
-    io_error = IO_DI_Get(IO_DI_67, &DI_136);
-    io_error = IO_DI_Get(IO_DI_68, &DI_113);
-}
-void CAN_CHANNEL_1(){
-IO_CAN_DATA_FRAME can_frame = {0};
-    {//MTU-SENSORS-1
-    can_frame.id = 255;
-    can_frame.id_format = IO_CAN_STD_FRAME;
-    can_frame.length = 8;
-    can_frame.data[0] = temp_n;
-    can_frame.data[1] = temp_v;
-    can_frame.data[2] = PTC_1;
-    can_frame.data[3] = PTC_2;
-    can_frame.data[4] = RP;
-    can_frame.data[5] = BMKD_1;
-    can_frame.data[6] = BMKD_2;
-    can_frame.data[7] = RG;
-
-    IO_CAN_WriteMsg(handle1_w,&can_frame);
-    while (IO_CAN_MsgStatus(handle1_w) != IO_E_OK);
+    SNAP_INPUTS * snap = SNAP_Back();
+    ubyte4 di;
+    ubyte1 i;
+
+    PROF_Begin(PROF_SECTION_SENSORS);
+    ADC_SCAN_Read(); //все AI одним проходом, свежесть в ADC_SCAN_fresh
+    LIN_ConvertAll(); //линеаризация всех каналов одним циклом, кривые из env/lincal.csv
+    DI_SCAN_Read();  //все DI одним проходом с антидребезгом
+    WHEEL_Read();    //скорость с аппаратных таймеров, раз в цикл
+
+    //снимок цикла целиком в задний буфер, публикация одним атомарным переключением
+    snap->tick = SCHED_GetTick();
+    snap->di   = DI_SCAN_State();
+    for (i = 0; i < ADC_SCAN_NUM_CHANNELS; i++){
+        snap->ai_raw[i] = (ubyte2)ADC_SCAN_values[i];
+        snap->ai_eng[i] = LIN_values[i];
     }
-    {//MTU-SENSORS-2
-    can_frame.id = 254;
-    can_frame.id_format = IO_CAN_STD_FRAME;
-    can_frame.length = 8;
-    can_frame.data[0] = LG;
-    can_frame.data[1] = TED;
-    can_frame.data[2] = FAN;
-    can_frame.data[3] = K1;
-    can_frame.data[4] = K2;
-    can_frame.data[5] = K3;
-    can_frame.data[6] = F;
-    can_frame.data[7] = 0;
-    IO_CAN_WriteMsg(handle1_w, &can_frame);
-    while (IO_CAN_MsgStatus(handle1_w) != IO_E_OK);
+    snap->ai_fresh = ADC_SCAN_fresh;
+    for (i = 0; i < WHEEL_NUM_CHANNELS; i++){
+        snap->wheel_q16[i] = WHEEL_Speed(i);
     }
+    snap->vehicle_speed_q16 = WHEEL_VehicleSpeed();
+    SNAP_Publish();
+
+    //инженерные значения для MTU-SENSORS-1: температуры в °C + 40, давление в 10 кПа
+    temp_n = (ubyte1)((snap->ai_eng[ADC_SCAN_IDX_AI_103] / 10) + 40);
+    temp_v = (ubyte1)((snap->ai_eng[ADC_SCAN_IDX_AI_127] / 10) + 40);
+    PTC_1  = (ubyte1)(snap->ai_eng[ADC_SCAN_IDX_AI_104] / 100);
+    PTC_2  = (ubyte1)(snap->ai_eng[ADC_SCAN_IDX_AI_128] / 100);
+
+    //дискретные сигналы для MTU-SENSORS-1/2 из упакованного слова
+    di = snap->di;
+    RP     = (ubyte1)((di & DI_SCAN_RP)     != 0u);
+    BMKD_1 = (ubyte1)((di & DI_SCAN_BMKD_1) != 0u);
+    BMKD_2 = (ubyte1)((di & DI_SCAN_BMKD_2) != 0u);
+    RG     = (ubyte1)((di & DI_SCAN_RG)     != 0u);
+    LG     = (ubyte1)((di & DI_SCAN_LG)     != 0u);
+    TED    = (ubyte1)((di & DI_SCAN_TED)    != 0u);
+    FAN    = (ubyte1)((di & DI_SCAN_FAN)    != 0u);
+    K1     = (ubyte1)((di & DI_SCAN_K1)     != 0u);
+    K2     = (ubyte1)((di & DI_SCAN_K2)     != 0u);
+    K3     = (ubyte1)((di & DI_SCAN_K3)     != 0u);
+    F      = (ubyte1)((di & DI_SCAN_F)      != 0u);
+    PROF_End(PROF_SECTION_SENSORS);
+}
+void CAN_CHANNEL_1(){//1 ms rate group: releases due messages, at most one frame per tick
+    PROF_Begin(PROF_SECTION_CAN1);
+    CAN_SCHED_Service(SCHED_GetTick()); // MTU-SENSORS-1/2 per their period/phase/deadline
+    PROF_End(PROF_SECTION_CAN1);
 }
 void CAN_CHANNEL_2(){
-    IO_CAN_DATA_FRAME INV_SENSORS_M = {0};
-    IO_CAN_DATA_FRAME INV_SENSORS_E = {0};
-    IO_CAN_DATA_FRAME INV_SENSORS_T = {0};
-    IO_CAN_DATA_FRAME MTU_SENSORS_M = {0};
-    IO_CAN_DATA_FRAME MTU_SENSORS_E = {0};
-    IO_CAN_DATA_FRAME MTU_SENSORS_T = {0};
-
-    MTU_SENSORS_M.id = 0x1C0;
-    MTU_SENSORS_M.id_format = IO_CAN_STD_FRAME;
-    MTU_SENSORS_M.lenght = 4;
-    MTU_SENSORS_M.id = 0x2C0;
-    MTU_SENSORS_M.id_format = IO_CAN_STD_FRAME;
-    MTU_SENSORS_M.lenght = 5;
-    MTU_SENSORS_M.id = 0x3C0;
-    MTU_SENSORS_M.id_format = IO_CAN_STD_FRAME;
-    MTU_SENSORS_M.lenght = 8;
-
-
-    if (IO_CAN_MsgStatus(handle_r_m) == IO_E_OK){
-        IO_CAN_ReadMsg(handle_r_m, &INV_SENSORS_M);
-        MTU_SENSORS_M = INV_SENSORS_M; //Maybe I will calrify this
-        IO_CAN_WriteMsg(handle2_w, &MTU_SENSORS_M);
-        while (IO_CAN_MsgStatus(handle2_w) != IO_E_OK);
-    }
-    if (IO_CAN_MsgStatus(handle_r_e) == IO_E_OK){
-        IO_CAN_ReadMsg(handle_r_e, &INV_SENSORS_E);
-        MTU_SENSORS_E = INV_SENSORS_E; //Maybe I will clarify this
-        IO_CAN_WriteMsg(handle2_w, &MTU_SENSORS_E);
-        while (IO_CAN_MsgStatus(handle2_w) != IO_E_OK);
+    IO_CAN_DATA_FRAME rx_frames[CAN2_RX_FIFO_SIZE];
+    ubyte1 rx_count = 0;
+    ubyte4 arrival_stamp = 0;
+    IO_ErrorType fifo_error;
+
+    PROF_Begin(PROF_SECTION_CAN2);
+
+    /* arrival stamp for the drained burst: the drain time is the earliest moment a frame
+     * is visible to us, so the per-route latency sections measure drain-to-retransmit --
+     * the up-to-one-poll-period wait in the hardware FIFO comes on top of the reported
+     * numbers and is bounded by this task's period */
+    (void)IO_RTC_StartTime(&arrival_stamp);
+
+    /* one drain services a whole burst: all frames received since the last poll */
+    fifo_error = IO_CAN_ReadFIFO(handle_r_fifo, rx_frames, CAN2_RX_FIFO_SIZE, &rx_count);
+    if (fifo_error == IO_E_CAN_FIFO_FULL){
+        can2_rx_overflow++; // frames were lost since the last poll
     }
-    if (IO_CAN_MsgStatus(handle_r_t) == IO_E_OK){
-        IO_CAN_ReadMsg(handle_r_t, &INV_SENSORS_T);
-        MTU_SENSORS_T = INV_SENSORS_T; //Maybe I will clarify this
-        IO_CAN_WriteMsg(handle2_w, &MTU_SENSORS_T);
-        while (IO_CAN_MsgStatus(handle2_w) != IO_E_OK);
+    else if ((fifo_error != IO_E_OK) && (fifo_error != IO_E_CAN_OLD_DATA)){
+        rx_count = 0;
     }
+
+    //сначала J1939 (TP-кадры и диагностика потребляются), остаток в шлюз
+    rx_count = J1939_Process(rx_frames, rx_count);
+    CAN_GW_Process(can2_routes, CAN2_ROUTE_COUNT, rx_frames, rx_count, arrival_stamp);
+    PROF_End(PROF_SECTION_CAN2);
 }
 void CAN_CHANNEL_3(){}
 void CAN_CHANNEL_4(){}
+//вентилятор: 0% до 60.0 °C самой горячей обмотки, линейно до 100% при 100.0 °C
+static ubyte2 FanDuty(const SNAP_INPUTS * const snap){
+    sbyte2 temp_max = snap->ai_eng[ADC_SCAN_IDX_AI_105];
+    ubyte1 i;
+
+    for (i = ADC_SCAN_IDX_AI_129; i <= ADC_SCAN_IDX_AI_131; i++){
+        if (snap->ai_eng[i] > temp_max){
+            temp_max = snap->ai_eng[i];
+        }
+    }
+    if (temp_max <= 600){
+        return 0;
+    }
+    if (temp_max >= 1000){
+        return 0xFFFF;
+    }
+    return (ubyte2)(((sbyte4)(temp_max - 600) * 0xFFFF) / 400);
+}
+//УПРАВЛЕНИЕ ТЭД: быстрая дорожка, 1 ms rate group сразу после Sensors() -- между съёмом
+//БМКД (DI_132/DI_109) и сбросом выходов нет ни CAN-задач, ни прочей фоновой работы,
+//наихудшая отсечка момента ~один тик; только защитный минимум: блокировки, ПИД, выходы
+void TorqueFast(){
+    const SNAP_INPUTS * snap = SNAP_Front(); //неизменный снимок входов этого цикла
+
+    PROF_Begin(PROF_SECTION_TORQUE);
+    static ubyte1 ted_was_on = 0;
+
+    if ((snap->di & DI_SCAN_TED_INTERLOCK) == DI_SCAN_TED_INTERLOCK)
+        {
+            sbyte4 setpoint = 286 + 514*(sbyte4)((snap->di & DI_SCAN_F) != 0u); //Уставка скорости, ФОРСАЖ
+            if (ted_was_on == 0u){
+                ODO_Increment(ODO_ID_TED_ENGAGE); //счётчик включений ТЭД, по фронту блокировки
+                ted_was_on = 1;
+            }
+            DO_OUT_Set(DO_OUT_ALL, TRUE); //ЗАПУСКАЕМ ТЭД: катушки БСКР
+            PWM_OUT_SetDuty(PWM_OUT_IDX_TED_RELAY, 0xFFFF); //реле ТЭД полностью
+            //замыкание по скорости: уставка в об/мин, обратная связь с датчиков PWD
+            sbyte4 k_q16 = PID_Update(&pid_torque,
+                                      PID_Q16(setpoint),
+                                      snap->vehicle_speed_q16);  // Измеренная скорость
+            Torque = (ubyte2)(((sbyte8)k_q16*setpoint) >> 16);
+        }
+    else //ОТКЛЮЧАЕМ ТЭД: торможение (БМКД разомкнут) или включена передача
+    {
+            ted_was_on = 0;
+            Torque = 0; //ОБНУЛЕНИЕ ПРИ ТОРМОЖЕНИИ: старый момент не должен уходить в отчёты
+            PID_Reset(&pid_torque); //без накопления интеграла пока ТЭД выключен
+            DO_OUT_Set(DO_OUT_ALL, FALSE);
+            PWM_OUT_SetDuty(PWM_OUT_IDX_TED_RELAY, 0);
+    }
+    io_error = DO_OUT_Flush(); //пишем в драйвер только изменившиеся биты
+    PROF_End(PROF_SECTION_TORQUE);
+}
+void FanControl(){//вентилятор не защитный: обороты по температуре обмоток, 10 ms хватает
+    PWM_OUT_SetDuty(PWM_OUT_IDX_FAN, FanDuty(SNAP_Front()));
+}
+void ProfilerReport(){//1 s rate group: per-section budget frames on CAN 1
+    PROF_Report(handle1_w);
+}
+void LogRecord(){//10 ms rate group: one flight recorder record per report cycle
+    const SNAP_INPUTS * snap = SNAP_Front(); //consistent view, same source as the control path
+    FLREC_RECORD rec;
+    ubyte1 i;
+
+    rec.tick = snap->tick;
+    for (i = 0; i < ADC_SCAN_NUM_CHANNELS; i++){
+        rec.ai[i] = snap->ai_raw[i];
+    }
+    rec.di     = snap->di;
+    rec.torque = Torque;
+    rec.flags  = 0;
+    FLREC_Log(&rec);
+}
+void Telemetry(){//10 ms rate group: one tuning snapshot over UDP multicast
+    TELEM_Send(SCHED_GetTick(), Torque, &pid_torque);
+}
+//коды событий DIAG_LOG_SRC_APPL в поле error_code кадра 0x710
+#define APPL_EVT_SCHED_OVERRUN  1   //SCHED_OverrunTicks()
+#define APPL_EVT_CANTX_DROPPED  2   //CAN_TX_DroppedFrames()
+#define APPL_EVT_CAN2_OVERFLOW  3   //can2_rx_overflow
+//одно событие на каждый прирост счётчика, текущее значение в faulty_value
+static void ReportCounter(ubyte1 event, ubyte4 value, ubyte4 * reported){
+    if (value != *reported){
+        DIAG_ERRORCODE code;
+
+        code.error_code   = event;
+        code.device_num   = 0;
+        code.faulty_value = value;
+        DIAG_LOG_Record(DIAG_LOG_SRC_APPL, 0, &code);
+        *reported = value;
+    }
+}
+void Housekeeping(){//100 ms rate group: slow diagnostics
+    PARAM_Task(); //асинхронная запись изменённых параметров в EEPROM
+    ODO_Task(); //моточасы и пакетная фиксация счётчиков в журнале EEPROM
+    FLREC_Task(); //фоновые стирание/запись внешней флеш-памяти
+    DIAG_LOG_Report(handle1_w); //накопленные события диагностики на CAN 1
+    FWUP_Task(); //фоновый приём блоков прошивки по Ethernet
+
+    //перепрошивка: запрос TTC-Downloader, переключаемся только с сохранёнными параметрами
+    if (IO_DOWNLOAD_CheckRequest() == IO_E_OK){
+        DO_OUT_Set(DO_OUT_ALL, FALSE); //безопасное состояние перед перезапуском
+        io_error = DO_OUT_Flush();
+        PWM_OUT_SetDuty(PWM_OUT_IDX_TED_RELAY, 0);
+        PWM_OUT_SetDuty(PWM_OUT_IDX_FAN, 0);
+        if (PARAM_IsClean() != FALSE){
+            (void)IO_DOWNLOAD_Launch(); //no return: the ECU restarts in download mode
+        }
+        //параметры ещё пишутся: окно запроса 3 с, попробуем в следующем цикле
+    }
+    //пропуски тиков и переполнения очередей -- событиями в DIAG_LOG, кадр 0x710 на CAN 1
+    {
+        static ubyte4 overruns_reported  = 0;
+        static ubyte4 dropped_reported   = 0;
+        static ubyte4 overflow_reported  = 0;
+
+        ReportCounter(APPL_EVT_SCHED_OVERRUN, SCHED_OverrunTicks(),     &overruns_reported);
+        ReportCounter(APPL_EVT_CANTX_DROPPED, CAN_TX_DroppedFrames(),   &dropped_reported);
+        ReportCounter(APPL_EVT_CAN2_OVERFLOW, can2_rx_overflow,         &overflow_reported);
+    }
+}
 
 /* ============================================================================================= */
 /*    Function Name:          main                                                               */
@@ -407,16 +560,12 @@ void CAN_CHANNEL_4(){}
 #pragma TASK( main );
 void main(void)
 {
-    {
-    volatile IO_ErrorType io_error = IO_E_OK;
-    ubyte4 timestamp = 0;
-
     /* safety configuration */
     IO_DRIVER_SAFETY_CONF safety_conf;
 
-    /* cycle period: 10 ms with 25% percent window size, no resets, 30 ms glitch filter, with error
-     * and notification callback */
-    safety_conf.command_period      = 10000;
+    /* cycle period: one scheduler tick (1 ms) with 25% percent window size, no resets, 30 ms
+     * glitch filter, with error and notification callback */
+    safety_conf.command_period      = SCHED_TICK_US;
     safety_conf.window_size         = SAFETY_CONF_WINDOW_SIZE_25_PERCENT;
     safety_conf.reset_behavior      = SAFETY_CONF_RESETS_DISABLED;
     safety_conf.glitch_filter_time  = 30;
@@ -428,55 +577,40 @@ void main(void)
 
     /* configure floating point exception handler */
     io_error = IO_Driver_SetFPUHandler(&APPL_FPUhandler);
-    }
 
     /* place your custom driver initialization here */
     Initialization();
-    /* start the RTC */
-    IO_RTC_StartTime(&timestamp);
+
+    /* rate groups: torque fast lane at 1 ms directly behind the input scan -- nothing runs
+     * between a BMKD drop in the snapshot and the output reset -- the MTU-SENSORS reports,
+     * the fan and the inverter gateway at 10 ms, slow diagnostics at 100 ms */
+    io_error = SCHED_Init();
+    io_error = SCHED_AddTask(&InitStaged,     1,   0); /* no-op once all stages ran */
+    io_error = SCHED_AddTask(&Sensors,        1,   0);
+    io_error = SCHED_AddTask(&TorqueFast,     1,   0); /* safety subset only, see TorqueFast */
+    io_error = SCHED_AddTask(&CAN_TX_Service, 1,   0);
+    io_error = SCHED_AddTask(&CAN_CHANNEL_1,  1,   0); /* TX scheduler needs every tick */
+    io_error = SCHED_AddTask(&CAN_CHANNEL_2,  10,  5); /* offset against CAN_CHANNEL_1 */
+    io_error = SCHED_AddTask(&FanControl,     10,  4); /* right before the duty refresh */
+    io_error = SCHED_AddTask(&PWM_OUT_Task,   10,  4); /* duty + batch current feedback */
+    io_error = SCHED_AddTask(&LogRecord,      10,  8);
+    io_error = SCHED_AddTask(&Telemetry,      10,  3);
+    io_error = SCHED_AddTask(&CONS_Task,      10,  6); /* service console: parse + trickle out */
+    io_error = SCHED_AddTask(&Housekeeping,   100, 7);
+    io_error = SCHED_AddTask(&ProfilerReport, 1000, 13);
 
     while (1)
     {
     io_error = IO_Driver_TaskBegin();
 
     /* application begin */
-    Sensors();
-
-    if (DI_132&&DI_109&&DI_133&&DI_110==TRUE)//УПРАВЛЕНИЕ ТЭД
-        {
-            {//ЗАПУСКАЕМ ТЭД
-            io_error = IO_DO_Set(IO_DO_16, TRUE); // Питание катушки 1 БСКР 149 pin
-            io_error = IO_DO_Set(IO_DO_17, TRUE); // Питание катушки 2 БСКР 173 pin
-            io_error = IO_DO_Set(IO_DO_18, TRUE); // Питание катушки 3 БСКР 152 pin
-            io_error = IO_DO_Set(IO_DO_19, TRUE); // Питание реле ТЭД 176 pin
-            io_error = IO_DO_Set(IO_DO_20, TRUE); // Питание реле вентилятора 155 pin
-            }
-            ubyte2 k = PID((ubute2)safety_conf.command_period, 0, 0, kp, ki, kd); // Коэффициент
-            Torque = k*(286 + 514*DI_113); // ДОБАВИТЬ ОБНУЛЕНИЕ ПРИ ТОРМОЖЕНИИ!!!
-        }
-    else //ОТКЛЮЧАЕМ ТЭД
-    {
-            io_error = IO_DO_Set(IO_DO_16, FALSE);
-            io_error = IO_DO_Set(IO_DO_17, FALSE);
-            io_error = IO_DO_Set(IO_DO_18, FALSE);
-            io_error = IO_DO_Set(IO_DO_19, FALSE);
-            io_error = IO_DO_Set(IO_DO_20, FALSE);
-    }
-
-    CAN_CHANNEL_1();
-    CAN_CHANNEL_2();
-    CAN_CHANNEL_3();
-    CAN_CHANNEL_4();
-
+    SCHED_Dispatch();
     /* application end */
 
     io_error = IO_Driver_TaskEnd();
 
-    /* wait until cycle time has passed */
-    while (IO_RTC_GetTimeUS(timestamp) < safety_conf.command_period) ;
-        
-    /* increase time stamp by cycle time */
-    timestamp += safety_conf.command_period;
+    /* wait for the next 1 ms tick from the periodic interrupt */
+    SCHED_WaitTick();
     }
 
 } /* END OF main */
@@ -491,9 +625,13 @@ static ubyte2 APPL_ErrorCb(ubyte1 diag_state,
 {
     /* decide, which reaction shall be taken */
 
-    (void)diag_state;
     (void)watchdog_state;
-    (void)error;
+
+    /* a few stores into the event ring, no driver calls in this context */
+    DIAG_LOG_Record(DIAG_LOG_SRC_ERROR, diag_state, error);
+
+    /* one RAM add, persisted later by the ODO journal */
+    ODO_Increment(ODO_ID_SAFESTATE);
 
     return DIAG_ERR_SAFESTATE;
 }
@@ -508,9 +646,10 @@ static void APPL_NotifyCb(ubyte1 diag_state,
 {
     /* no decision can be done here */
 
-    (void)diag_state;
     (void)watchdog_state;
-    (void)error;
+
+    /* a few stores into the event ring, no driver calls in this context */
+    DIAG_LOG_Record(DIAG_LOG_SRC_NOTIFY, diag_state, error);
 }
 
 /* ============================================================================================= */